@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+// Округляет bytes вверх до кратного Alignment
+template <size_t Alignment>
+constexpr size_t RoundUpToAlignment(size_t bytes) noexcept {
+    return (bytes + Alignment - 1) & ~(Alignment - 1);
+}
+
+// Аллокатор буферов, выровненных на Alignment байт. Размер выделения округляется
+// до кратного Alignment, поэтому буферы соседних векторов не делят кэш-линию.
+// Хвост округления отдаётся вектору через UsableSize, и ёмкость тоже оказывается округлённой
+template <typename Type, size_t Alignment>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "Alignment is weaker than the element alignment");
+
+public:
+    using value_type = Type;
+    static constexpr size_t kAlignment = Alignment;
+
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment>&) noexcept {}
+
+    Type* allocate(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - Alignment) / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(::operator new(RoundUpToAlignment<Alignment>(n * sizeof(Type)),
+                                                 std::align_val_t{Alignment}));
+    }
+
+    // Сколько элементов помещается в блок, который allocate(n) выделяет на самом деле
+    size_t UsableSize(size_t n) const noexcept {
+        return RoundUpToAlignment<Alignment>(n * sizeof(Type)) / sizeof(Type);
+    }
+
+    void deallocate(Type* ptr, size_t n) noexcept {
+        ::operator delete(ptr, RoundUpToAlignment<Alignment>(n * sizeof(Type)), std::align_val_t{Alignment});
+    }
+};
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+bool operator==(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs, size_t Alignment>
+bool operator!=(const AlignedAllocator<Lhs, Alignment>&, const AlignedAllocator<Rhs, Alignment>&) noexcept {
+    return false;
+}
+
+// Рост по политике Base с округлением ёмкости так, чтобы буфер занимал
+// целое число блоков по Alignment байт. С AlignedAllocator то же даёт UsableSize,
+// политика нужна для аллокаторов, которые о своём округлении не сообщают
+template <size_t Alignment, typename Base = DoublingGrowth>
+struct AlignedGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t target = Base::NextCapacity(capacity, required, element_size);
+        if (target > (std::numeric_limits<size_t>::max() - Alignment) / element_size) {
+            return target;
+        }
+        return std::max(target, RoundUpToAlignment<Alignment>(target * element_size) / element_size);
+    }
+};
+
+// Вектор с буфером, выровненным на Alignment байт (по умолчанию — кэш-линия)
+template <typename Type, size_t Alignment = 64>
+using AlignedSimpleVector = SimpleVector<Type, AlignedAllocator<Type, Alignment>, AlignedGrowth<Alignment>>;
@@ -1,41 +1,112 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
+// Указатель ptr выровнен на alignment байт (степень двойки)
 template <typename Type>
+bool IsAlignedPointer(const Type* ptr, size_t alignment) noexcept {
+    return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+// Сообщает компилятору, что ptr выровнен на Alignment байт, чтобы векторизованный
+// цикл обошёлся без пролога для невыровненного начала. Выравнивание проверяет assert
+template <size_t Alignment, typename Type>
+Type* AssumeAligned(Type* ptr) noexcept {
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    assert(IsAlignedPointer(ptr, Alignment) && "Pointer is not aligned");
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<Type*>(__builtin_assume_aligned(ptr, Alignment));
+#else
+    return ptr;
+#endif
+}
+
+// Аллокатор умеет увеличивать выделенный блок на месте:
+// bool TryExtend(pointer p, size_t n, size_t new_n) noexcept
+template <typename Allocator, typename = void>
+inline constexpr bool kAllocatorCanExtend = false;
+
+template <typename Allocator>
+inline constexpr bool kAllocatorCanExtend<Allocator, std::void_t<decltype(std::declval<Allocator&>().TryExtend(
+    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{}, size_t{}))>> = true;
+
+// Аллокатор умеет менять размер блока, при необходимости перенося его побайтово, как realloc:
+// pointer Reallocate(pointer p, size_t n, size_t new_n) noexcept.
+// nullptr означает неудачу, и тогда блок p остаётся прежним
+template <typename Allocator, typename = void>
+inline constexpr bool kAllocatorCanReallocate = false;
+
+template <typename Allocator>
+inline constexpr bool kAllocatorCanReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().Reallocate(
+    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{}, size_t{}))>> = true;
+
+// Аллокатор выделяет блоки с запасом и сообщает, сколько элементов в них помещается:
+// size_t UsableSize(size_t n) const noexcept, не меньше n. ArrayPtr считает запас своими слотами
+template <typename Allocator, typename = void>
+inline constexpr bool kAllocatorHasUsableSize = false;
+
+template <typename Allocator>
+inline constexpr bool kAllocatorHasUsableSize<Allocator, std::void_t<decltype(
+    std::declval<const Allocator&>().UsableSize(size_t{}))>> = true;
+
+// Владеет неинициализированным буфером под size объектов Type.
+// Память выделяется и освобождается через Allocator,
+// конструированием и разрушением элементов занимается владелец буфера.
+template <typename Type, typename Allocator = std::allocator<Type>>
 class ArrayPtr {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>,
+                  "Allocator::value_type must match Type");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, Type*>,
+                  "Fancy allocator pointers are not supported");
+
 public:
+    using allocator_type = Allocator;
+
     ArrayPtr() = default;
 
-    explicit ArrayPtr(size_t size) : raw_ptr_(size == 0 ? nullptr : new Type[size]) {}
+    explicit ArrayPtr(const Allocator& alloc) noexcept : alloc_(alloc) {}
 
-    explicit ArrayPtr(Type* raw_ptr) noexcept : raw_ptr_(raw_ptr) {}
+    explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator())
+        : alloc_(alloc), raw_ptr_(Allocate(alloc_, size)), size_(UsableSize(alloc_, size)) {}
+
+    // raw_ptr должен быть получен через ArrayPtr::Release с тем же size и аллокатором
+    ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept
+        : alloc_(alloc), raw_ptr_(raw_ptr), size_(size) {}
 
     ~ArrayPtr() {
-        delete[] raw_ptr_;
+        Deallocate();
     }
 
     ArrayPtr(const ArrayPtr&) = delete;
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    ArrayPtr(ArrayPtr&& other) noexcept : raw_ptr_(other.raw_ptr_) {
-        other.raw_ptr_ = nullptr;
-    }
+    ArrayPtr(ArrayPtr&& other) noexcept
+        : alloc_(std::move(other.alloc_)),
+          raw_ptr_(std::exchange(other.raw_ptr_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
 
+    // Буфер всегда уходит вместе со своим аллокатором, иначе его нечем освободить.
+    // Правила propagate_on_container_* применяет владелец (SimpleVector).
     ArrayPtr& operator=(ArrayPtr&& other) noexcept {
         if (this != &other) {
-            delete[] raw_ptr_;
-            raw_ptr_ = other.raw_ptr_;
-            other.raw_ptr_ = nullptr;
+            Deallocate();
+            alloc_ = std::move(other.alloc_);
+            raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+            size_ = std::exchange(other.size_, 0);
         }
         return *this;
     }
 
     [[nodiscard]] Type* Release() noexcept {
-        Type* temp = raw_ptr_;
-        raw_ptr_ = nullptr;
-        return temp;
+        size_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
     }
 
     Type& operator[](size_t index) noexcept {
@@ -46,6 +117,33 @@ public:
         return raw_ptr_[index];
     }
 
+    // Увеличивает буфер до new_size слотов без переноса, если аллокатор это умеет
+    bool TryExtend(size_t new_size) noexcept {
+        if constexpr (kAllocatorCanExtend<Allocator>) {
+            if (raw_ptr_ != nullptr && new_size > size_ && alloc_.TryExtend(raw_ptr_, size_, new_size)) {
+                size_ = new_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Меняет размер буфера до new_size слотов, возможно перенося его на новый адрес побайтово.
+    // Живые элементы переезжают вместе с буфером, поэтому вызывать можно только
+    // для типов, которые разрешено переносить memcpy (kRelocateBitwise)
+    bool TryReallocate(size_t new_size) noexcept {
+        if constexpr (kAllocatorCanReallocate<Allocator>) {
+            if (raw_ptr_ != nullptr && new_size != 0) {
+                if (Type* moved = alloc_.Reallocate(raw_ptr_, size_, new_size)) {
+                    raw_ptr_ = moved;
+                    size_ = new_size;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     explicit operator bool() const {
         return raw_ptr_ != nullptr;
     }
@@ -54,10 +152,51 @@ public:
         return raw_ptr_;
     }
 
+    // Количество слотов в буфере
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    Allocator& GetAllocator() noexcept {
+        return alloc_;
+    }
+
+    // Обменивает буферы вместе с аллокаторами
     void swap(ArrayPtr& other) noexcept {
-        std::swap(raw_ptr_, other.raw_ptr_);
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        swap(raw_ptr_, other.raw_ptr_);
+        swap(size_, other.size_);
+    }
+
+    // Сколько слотов получит буфер, если запросить size: аллокатор может округлять выделение
+    static size_t UsableSize(const Allocator& alloc, size_t size) noexcept {
+        if constexpr (kAllocatorHasUsableSize<Allocator>) {
+            return size == 0 ? 0 : alloc.UsableSize(size);
+        }
+        else {
+            (void)alloc;
+            return size;
+        }
     }
 
 private:
+    // Выделяет память без вызова конструкторов
+    static Type* Allocate(Allocator& alloc, size_t size) {
+        return size == 0 ? nullptr : AllocTraits::allocate(alloc, size);
+    }
+
+    void Deallocate() noexcept {
+        if (raw_ptr_ != nullptr) {
+            AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_;
     Type* raw_ptr_ = nullptr;
+    size_t size_ = 0;
 };
@@ -0,0 +1,242 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "array_ptr.h"
+#include "relocate.h"
+#include "simple_vector.h"
+
+// Вектор для одновременного добавления из многих потоков.
+// Слот под новый элемент резервируется атомарным fetch_add, а элементы лежат в сегментах,
+// которые никогда не перемещаются: сегмент 0 вмещает kFirstSegment элементов,
+// сегмент k > 0 — kFirstSegment << (k - 1), так что ссылки на элементы стабильны.
+// PushBack/EmplaceBack и чтение уже добавленных элементов безопасны одновременно;
+// Freeze, Clear и разрушение требуют, чтобы производители закончили работу. Вектор не
+// копируется и не перемещается: производители держат ссылки на него и на его элементы
+template <typename Type>
+class ConcurrentSimpleVector {
+    static constexpr size_t kFirstSegmentBits = 5;
+    static constexpr size_t kFirstSegment = size_t{1} << kFirstSegmentBits;
+    static constexpr size_t kSegmentCount = sizeof(size_t) * CHAR_BIT - kFirstSegmentBits + 1;
+
+    using Storage = ArrayPtr<Type>;
+
+public:
+    // Запас под одну запись о неудачном слоте выделяется заранее, чтобы сама запись не бросала
+    ConcurrentSimpleVector()
+        : failed_(Reserve(kFailedReserve)) {}
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+    }
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    // Добавление элемента в конец
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в зарезервированном слоте. Ссылка остаётся верной до Clear/Freeze.
+    // Если выделение сегмента или конструктор бросает исключение, слот остаётся пустым
+    // и пропускается при Freeze
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            Type* slot = SlotFor(index);
+            ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+            return *slot;
+        }
+        catch (...) {
+            RecordFailed(index);
+            throw;
+        }
+    }
+
+    // Число зарезервированных слотов, включая те, что ещё заполняются другими потоками
+    size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Элемент index должен быть уже добавлен (например, его индекс получен от производителя)
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize() && "Index out of range");
+        return *ExistingSlot(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize() && "Index out of range");
+        return *ExistingSlot(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *ExistingSlot(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *ExistingSlot(index);
+    }
+
+    // Разрушает элементы и освобождает сегменты. Не должно пересекаться с производителями
+    void Clear() noexcept {
+        ForEachLiveRun([](Type* first, size_t count) {
+            std::destroy_n(first, count);
+        });
+        for (size_t segment = 0; segment < kSegmentCount; ++segment) {
+            if (Type* raw = segments_[segment].exchange(nullptr, std::memory_order_relaxed)) {
+                Storage(raw, SegmentSize(segment)); // Освобождает память сегмента
+            }
+        }
+        size_.store(0, std::memory_order_relaxed);
+        failed_.Clear();
+    }
+
+    // Переносит элементы в непрерывный SimpleVector одним выделением и поштучным
+    // (для тривиальных типов — побайтовым) переносом каждого сегмента. Оставляет вектор пустым.
+    // Не должно пересекаться с производителями
+    SimpleVector<Type> Freeze() {
+        const size_t live = GetSize() - failed_.GetSize();
+
+        SimpleVector<Type> result(Reserve(live));
+        result.ConstructBack(live, [&](Type* raw, size_t) {
+            size_t relocated = 0;
+            try {
+                ForEachLiveRun([&](Type* first, size_t count) {
+                    UninitializedRelocate(first, count, raw + relocated);
+                    relocated += count;
+                });
+            }
+            catch (...) {
+                std::destroy_n(raw, relocated);
+                throw;
+            }
+        });
+
+        ForEachLiveRun([](Type* first, size_t count) {
+            DestroyRelocated(first, count);
+        });
+        failed_.Clear();
+        size_.store(0, std::memory_order_relaxed);
+        Clear();
+        return result;
+    }
+
+private:
+    std::atomic<size_t> size_ = 0;
+    std::array<std::atomic<Type*>, kSegmentCount> segments_{};
+    std::mutex failed_mutex_;
+    SimpleVector<size_t> failed_; // Индексы слотов, чьё создание завершилось исключением
+
+    static constexpr size_t kFailedReserve = 8;
+
+    // Запоминает неудачный слот в заранее выделенном запасе и пытается восстановить запас.
+    // Не бросает: если восстановить запас не удалось и следующая запись тоже не сможет
+    // выделить память, программа завершится через std::terminate, а не разрушит мусор
+    void RecordFailed(size_t index) noexcept {
+        std::lock_guard lock(failed_mutex_);
+        failed_.PushBack(index);
+        if (failed_.GetSize() == failed_.GetCapacity()) {
+            try {
+                failed_.Reserve(failed_.GetCapacity() * 2);
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    static size_t HighestBit(size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(value);
+#else
+        size_t bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static size_t SegmentOf(size_t index) noexcept {
+        return index < kFirstSegment ? 0 : HighestBit(index >> kFirstSegmentBits) + 1;
+    }
+
+    static size_t SegmentBegin(size_t segment) noexcept {
+        return segment == 0 ? 0 : kFirstSegment << (segment - 1);
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return segment == 0 ? kFirstSegment : kFirstSegment << (segment - 1);
+    }
+
+    Type* ExistingSlot(size_t index) const noexcept {
+        const size_t segment = SegmentOf(index);
+        return segments_[segment].load(std::memory_order_acquire) + (index - SegmentBegin(segment));
+    }
+
+    // Слот index; сегмент выделяется первым добравшимся до него потоком
+    Type* SlotFor(size_t index) {
+        const size_t segment = SegmentOf(index);
+        Type* raw = segments_[segment].load(std::memory_order_acquire);
+        if (raw == nullptr) {
+            Storage fresh(SegmentSize(segment));
+            if (segments_[segment].compare_exchange_strong(raw, fresh.Get(), std::memory_order_acq_rel,
+                                                           std::memory_order_acquire)) {
+                raw = fresh.Release();
+            }
+            // Иначе сегмент уже выделил другой поток: raw указывает на него, fresh освободится
+        }
+        return raw + (index - SegmentBegin(segment));
+    }
+
+    // Обходит непрерывные отрезки живых элементов, пропуская слоты из failed_
+    template <typename Callback>
+    void ForEachLiveRun(Callback&& callback) {
+        std::sort(failed_.begin(), failed_.end());
+        const size_t size = GetSize();
+        const size_t* failed = failed_.begin();
+        const size_t* failed_end = failed_.end();
+
+        for (size_t segment = 0; segment < kSegmentCount && SegmentBegin(segment) < size; ++segment) {
+            Type* raw = segments_[segment].load(std::memory_order_acquire);
+            size_t run_begin = SegmentBegin(segment);
+            const size_t segment_end = std::min(size, SegmentBegin(segment) + SegmentSize(segment));
+            while (run_begin < segment_end) {
+                while (run_begin < segment_end && failed != failed_end && *failed == run_begin) {
+                    ++failed;
+                    ++run_begin;
+                }
+                size_t run_end = segment_end;
+                if (failed != failed_end && *failed < segment_end) {
+                    run_end = *failed;
+                }
+                if (run_begin < run_end) {
+                    callback(raw + (run_begin - SegmentBegin(segment)), run_end - run_begin);
+                }
+                run_begin = run_end;
+            }
+        }
+    }
+};
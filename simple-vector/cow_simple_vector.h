@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "simd_kernels.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Вектор с копированием при записи для редко изменяемых снимков.
+// Копии делят один буфер со счётчиком ссылок, копирование — O(1).
+// Первая изменяющая операция над разделяемым буфером делает себе глубокую копию.
+// Счётчик атомарный: копии одного буфера можно отдавать в разные потоки,
+// но один объект CowSimpleVector, как и SimpleVector, одновременно не используется.
+//
+// Изменяемые ссылки и итераторы (неконстантные operator[], At, begin, end) помечают буфер
+// как «утёкший»: пока он жив, копии этого вектора глубокие, иначе запись по старой ссылке
+// была бы видна в копии. Для разовой записи без этого эффекта есть Set
+template <typename Type>
+class CowSimpleVector {
+    using Vector = SimpleVector<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    CowSimpleVector() noexcept = default;
+
+    explicit CowSimpleVector(size_t size)
+        : shared_(new Shared{Vector(size)}) {}
+
+    CowSimpleVector(size_t size, const Type& value)
+        : shared_(new Shared{Vector(size, value)}) {}
+
+    CowSimpleVector(std::initializer_list<Type> init)
+        : shared_(new Shared{Vector(init)}) {}
+
+    // Забирает буфер готового вектора без копирования
+    explicit CowSimpleVector(Vector&& v)
+        : shared_(new Shared{std::move(v)}) {}
+
+    ~CowSimpleVector() {
+        Unref();
+    }
+
+    // Конструктор копирования: делит буфер с other
+    CowSimpleVector(const CowSimpleVector& other)
+        : shared_(other.shared_) {
+        if (shared_ == nullptr) {
+            return;
+        }
+        if (shared_->leaked) {
+            shared_ = new Shared{shared_->data};
+        }
+        else {
+            shared_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowSimpleVector(CowSimpleVector&& other) noexcept
+        : shared_(std::exchange(other.shared_, nullptr)) {}
+
+    CowSimpleVector& operator=(const CowSimpleVector& other) {
+        if (this != &other) {
+            CowSimpleVector tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    CowSimpleVector& operator=(CowSimpleVector&& other) noexcept {
+        if (this != &other) {
+            Unref();
+            shared_ = std::exchange(other.shared_, nullptr);
+        }
+        return *this;
+    }
+
+    // Доступ на чтение не копирует буфер
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize() && "Index out of range");
+        return shared_->data[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return shared_->data[index];
+    }
+
+    ConstIterator begin() const noexcept {
+        return shared_ == nullptr ? nullptr : shared_->data.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return shared_ == nullptr ? nullptr : shared_->data.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    ConstSimpleVectorView<Type> View() const noexcept {
+        return {begin(), GetSize()};
+    }
+
+    size_t GetSize() const noexcept {
+        return shared_ == nullptr ? 0 : shared_->data.GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return shared_ == nullptr ? 0 : shared_->data.GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Буфер разделяют и другие копии
+    bool IsShared() const noexcept {
+        return shared_ != nullptr && shared_->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    ConstIterator Find(const Type& value) const {
+        return begin() + RangeFind(begin(), GetSize(), value);
+    }
+
+    size_t Count(const Type& value) const {
+        return RangeCount(begin(), GetSize(), value);
+    }
+
+    bool Contains(const Type& value) const {
+        return Find(value) != end();
+    }
+
+    // Изменяемый доступ: отделяет буфер и помечает его утёкшим
+
+    Type& operator[](size_t index) {
+        assert(index < GetSize() && "Index out of range");
+        return Leak()[index];
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return Leak()[index];
+    }
+
+    Iterator begin() {
+        return shared_ == nullptr ? nullptr : Leak().begin();
+    }
+
+    Iterator end() {
+        return shared_ == nullptr ? nullptr : Leak().end();
+    }
+
+    // Запись элемента без выдачи ссылки наружу
+    void Set(size_t index, Type value) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        Detach(GetCapacity())[index] = std::move(value);
+    }
+
+    // Изменяющие операции; копия буфера сохраняет его ёмкость
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        // Копия сразу получает место под новый элемент, без второго перевыделения
+        const size_t size = GetSize();
+        const size_t capacity = size < GetCapacity() ? GetCapacity() : DoublingGrowth::NextCapacity(size, size + 1, sizeof(Type));
+        return Detach(capacity).EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    ConstIterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    ConstIterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    ConstIterator Emplace(ConstIterator pos, Args&&... args) {
+        if (pos < cbegin() || pos > cend()) {
+            throw std::out_of_range("Insert position out of range");
+        }
+        const size_t index = pos - cbegin();
+        Vector& data = Detach(std::max(GetCapacity(), GetSize() + 1));
+        return data.Emplace(data.cbegin() + index, std::forward<Args>(args)...);
+    }
+
+    ConstIterator Erase(ConstIterator pos) {
+        if (pos < cbegin() || pos >= cend()) {
+            throw std::out_of_range("Erase position out of range");
+        }
+        const size_t index = pos - cbegin();
+        Vector& data = Detach(GetCapacity());
+        return data.Erase(data.cbegin() + index);
+    }
+
+    void PopBack() {
+        assert(GetSize() > 0 && "PopBack called on an empty container");
+        Detach(GetCapacity()).PopBack();
+    }
+
+    void Resize(size_t new_size) {
+        Detach(std::max(GetCapacity(), new_size)).Resize(new_size);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Detach(new_capacity).Reserve(new_capacity);
+        }
+    }
+
+    // Разделяемый буфер просто отпускается, без копирования
+    void Clear() noexcept {
+        if (shared_ != nullptr && shared_->refs.load(std::memory_order_acquire) == 1) {
+            shared_->data.Clear();
+        }
+        else {
+            Unref();
+            shared_ = nullptr;
+        }
+    }
+
+    void swap(CowSimpleVector& other) noexcept {
+        std::swap(shared_, other.shared_);
+    }
+
+private:
+    struct Shared {
+        Vector data;
+        std::atomic<size_t> refs = 1;
+        bool leaked = false; // Наружу выданы изменяемые ссылки; меняет только единственный владелец
+    };
+
+    Shared* shared_ = nullptr;
+
+    void Unref() noexcept {
+        if (shared_ != nullptr && shared_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete shared_;
+        }
+    }
+
+    // Делает буфер единственным; новая копия вмещает не меньше capacity элементов.
+    // Единственный буфер не перевыделяется, чтобы рост оставался за политикой SimpleVector
+    Vector& Detach(size_t capacity) {
+        if (shared_ == nullptr) {
+            shared_ = new Shared{Vector(::Reserve(capacity))};
+        }
+        else if (shared_->refs.load(std::memory_order_acquire) != 1) {
+            Vector copy(::Reserve(std::max(capacity, GetSize())));
+            copy.Append(shared_->data.begin(), shared_->data.end());
+            Shared* fresh = new Shared{std::move(copy)};
+            Unref();
+            shared_ = fresh;
+        }
+        return shared_->data;
+    }
+
+    Vector& Leak() {
+        Vector& data = Detach(GetCapacity());
+        shared_->leaked = true;
+        return data;
+    }
+};
+
+// Операторы сравнения
+
+template <typename Type>
+inline bool operator<(const CowSimpleVector<Type>& lhs, const CowSimpleVector<Type>& rhs) {
+    return RangeLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type>
+inline bool operator==(const CowSimpleVector<Type>& lhs, const CowSimpleVector<Type>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() &&
+        (lhs.begin() == rhs.begin() || RangeEqual(lhs.begin(), rhs.begin(), lhs.GetSize()));
+}
+
+template <typename Type>
+inline bool operator!=(const CowSimpleVector<Type>& lhs, const CowSimpleVector<Type>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+inline bool operator>(const CowSimpleVector<Type>& lhs, const CowSimpleVector<Type>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type>
+inline bool operator<=(const CowSimpleVector<Type>& lhs, const CowSimpleVector<Type>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type>
+inline bool operator>=(const CowSimpleVector<Type>& lhs, const CowSimpleVector<Type>& rhs) {
+    return !(lhs < rhs);
+}
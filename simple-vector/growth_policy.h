@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+// Политики роста ёмкости. NextCapacity возвращает новую ёмкость не меньше required
+// для вектора текущей ёмкостью capacity с элементами размером element_size байт.
+
+// Рост в два раза
+struct DoublingGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        const size_t doubled = capacity > std::numeric_limits<size_t>::max() / 2
+            ? std::numeric_limits<size_t>::max()
+            : capacity * 2;
+        return std::max(doubled, required);
+    }
+};
+
+// Рост в полтора раза: сумма освобождённых ранее блоков со временем
+// становится достаточной для нового, и аллокатор может их переиспользовать
+struct GoldenGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        const size_t grown = capacity > std::numeric_limits<size_t>::max() - capacity / 2
+            ? std::numeric_limits<size_t>::max()
+            : capacity + capacity / 2;
+        return std::max(grown, required);
+    }
+};
+
+// Рост в два раза с округлением размера блока до класса размеров аллокатора:
+// небольшие блоки округляются до степени двойки байт, крупные — до целого числа страниц
+template <size_t PageSize = 4096>
+struct PageRoundedGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageSize must be a power of two");
+
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t target = DoublingGrowth::NextCapacity(capacity, required, element_size);
+        if (target > std::numeric_limits<size_t>::max() / element_size - PageSize) {
+            return target;
+        }
+
+        const size_t bytes = target * element_size;
+        size_t rounded = PageSize;
+        if (bytes < PageSize) {
+            rounded = 1;
+            while (rounded < bytes) {
+                rounded <<= 1;
+            }
+        }
+        else {
+            rounded = (bytes + PageSize - 1) & ~(PageSize - 1);
+        }
+        return std::max(target, rounded / element_size);
+    }
+};
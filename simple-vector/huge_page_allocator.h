@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+// Размер большой страницы x86-64 и AArch64 с 4K-страницами
+inline constexpr size_t kHugePageSize = size_t{2} << 20;
+
+// Настройки HugePageAllocator
+struct HugePageOptions {
+    size_t threshold = kHugePageSize; // Блоки от threshold байт отображаются через mmap, меньшие — из кучи
+    int numa_node = -1;               // Узел NUMA, к которому mbind привязывает страницы; -1 — без привязки
+    bool use_hugetlb = false;         // Сначала MAP_HUGETLB из зарезервированного пула, при неудаче — обычный mmap
+};
+
+// Аллокатор для очень больших векторов. Крупные блоки — анонимные отображения длиной
+// в целое число больших страниц, выровненные на kHugePageSize и помеченные MADV_HUGEPAGE,
+// чтобы их покрывали большие страницы и промахов TLB было меньше.
+// Рост крупного блока идёт через mremap: TryExtend растит его на месте, а Reallocate
+// переносит страницы на новый адрес без копирования данных. Мелкие блоки берутся из кучи.
+// Путь выбирается по размеру блока, поэтому копии аллокатора должны иметь одинаковый threshold
+template <typename Type>
+class HugePageAllocator {
+    static_assert(alignof(Type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned types are not supported");
+
+public:
+    using value_type = Type;
+
+    HugePageAllocator() noexcept = default;
+
+    explicit HugePageAllocator(const HugePageOptions& options) noexcept
+        : options_(options) {}
+
+    template <typename Other>
+    HugePageAllocator(const HugePageAllocator<Other>& other) noexcept
+        : options_(other.GetOptions()) {}
+
+    Type* allocate(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - kHugePageSize) / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(Type);
+        if (!IsMapped(bytes)) {
+            return static_cast<Type*>(::operator new(bytes));
+        }
+        return static_cast<Type*>(Map(MappedLength(bytes)));
+    }
+
+    void deallocate(Type* ptr, size_t n) noexcept {
+        const size_t bytes = n * sizeof(Type);
+        if (IsMapped(bytes)) {
+            ::munmap(ptr, MappedLength(bytes));
+        }
+        else {
+            ::operator delete(ptr);
+        }
+    }
+
+    // Растит отображённый блок на месте. Хвост последней большой страницы уже отображён,
+    // в его пределах рост бесплатен; дальше — mremap без переноса
+    bool TryExtend(Type* ptr, size_t n, size_t new_n) noexcept {
+        if (new_n > (std::numeric_limits<size_t>::max() - kHugePageSize) / sizeof(Type)) {
+            return false;
+        }
+        const size_t bytes = n * sizeof(Type);
+        if (!IsMapped(bytes)) {
+            return false;
+        }
+        const size_t length = MappedLength(bytes);
+        const size_t new_length = MappedLength(new_n * sizeof(Type));
+        if (new_length == length) {
+            return true;
+        }
+#ifdef MREMAP_MAYMOVE
+        return ::mremap(ptr, length, new_length, 0) != MAP_FAILED;
+#else
+        return false;
+#endif
+    }
+
+    // Меняет длину отображённого блока через mremap, перенося страницы при необходимости.
+    // Атрибуты отображения (MADV_HUGEPAGE, привязка к узлу) переезжают вместе с ним.
+    // Блоки из кучи не переносятся: nullptr
+    Type* Reallocate(Type* ptr, size_t n, size_t new_n) noexcept {
+        if (new_n > (std::numeric_limits<size_t>::max() - kHugePageSize) / sizeof(Type)) {
+            return nullptr;
+        }
+        const size_t bytes = n * sizeof(Type);
+        const size_t new_bytes = new_n * sizeof(Type);
+        if (!IsMapped(bytes) || !IsMapped(new_bytes)) {
+            return nullptr;
+        }
+        const size_t length = MappedLength(bytes);
+        const size_t new_length = MappedLength(new_bytes);
+        if (new_length == length) {
+            return ptr;
+        }
+#ifdef MREMAP_MAYMOVE
+        void* moved = ::mremap(ptr, length, new_length, MREMAP_MAYMOVE);
+        return moved == MAP_FAILED ? nullptr : static_cast<Type*>(moved);
+#else
+        return nullptr;
+#endif
+    }
+
+    const HugePageOptions& GetOptions() const noexcept {
+        return options_;
+    }
+
+private:
+    HugePageOptions options_;
+
+    bool IsMapped(size_t bytes) const noexcept {
+        return bytes >= options_.threshold;
+    }
+
+    static size_t MappedLength(size_t bytes) noexcept {
+        return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    }
+
+    // Отображает length байт (кратно kHugePageSize) с выравниванием на большую страницу
+    void* Map(size_t length) const {
+        void* map = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (options_.use_hugetlb) {
+            map = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (map == MAP_FAILED) {
+            map = MapAligned(length);
+        }
+        if (options_.numa_node >= 0) {
+            Bind(map, length);
+        }
+        return map;
+    }
+
+    // Отображает с запасом в одну большую страницу и обрезает края до выровненного участка
+    static void* MapAligned(size_t length) {
+        void* raw = ::mmap(nullptr, length + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char* begin = static_cast<char*>(raw);
+        char* aligned = begin + (kHugePageSize - reinterpret_cast<std::uintptr_t>(begin) % kHugePageSize) % kHugePageSize;
+        if (aligned != begin) {
+            ::munmap(begin, aligned - begin);
+        }
+        ::munmap(aligned + length, begin + kHugePageSize - aligned);
+#ifdef MADV_HUGEPAGE
+        ::madvise(aligned, length, MADV_HUGEPAGE); // Подсказка: без THP в ядре страницы останутся обычными
+#endif
+        return aligned;
+    }
+
+    // Привязывает страницы к узлу options_.numa_node (MPOL_BIND) без зависимости от libnuma.
+    // Несуществующий узел — ошибка конфигурации: отображение снимается, бросается system_error
+    void Bind(void* map, size_t length) const {
+#ifdef SYS_mbind
+        constexpr int kMpolBind = 2;
+        constexpr size_t kMaskBits = sizeof(unsigned long) * 8;
+        constexpr size_t kMaxNodes = 1024;
+        unsigned long mask[kMaxNodes / kMaskBits] = {};
+        const size_t node = static_cast<size_t>(options_.numa_node);
+        int error = EINVAL;
+        if (node < kMaxNodes) {
+            mask[node / kMaskBits] = 1UL << (node % kMaskBits);
+            error = ::syscall(SYS_mbind, map, length, kMpolBind, mask, kMaxNodes + 1, 0) == 0 ? 0 : errno;
+        }
+        if (error != 0) {
+            ::munmap(map, length);
+            throw std::system_error(error, std::generic_category(), "mbind");
+        }
+#else
+        (void)map;
+        (void)length;
+#endif
+    }
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const HugePageAllocator<Lhs>& lhs, const HugePageAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetOptions().threshold == rhs.GetOptions().threshold;
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const HugePageAllocator<Lhs>& lhs, const HugePageAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// Вектор на больших страницах. Крупные буферы растут целыми большими страницами,
+// тривиально копируемые элементы при росте не копируются (mremap)
+template <typename Type>
+using HugePageSimpleVector = SimpleVector<Type, HugePageAllocator<Type>, PageRoundedGrowth<kHugePageSize>>;
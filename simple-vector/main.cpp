@@ -1,9 +1,39 @@
 #include "simple_vector.h"
+#include "small_simple_vector.h"
+#include "parallel_algorithms.h"
+#include "concurrent_simple_vector.h"
+#include "simple_vector_collector.h"
+#include "mapped_simple_vector.h"
+#include "simple_vector_io.h"
+#include "huge_page_allocator.h"
+#include "realloc_allocator.h"
+#include "segmented_simple_vector.h"
+#include "simple_flat_map.h"
+#include "simple_ring_vector.h"
+#include "simple_vector_view.h"
+#include "cow_simple_vector.h"
+#include "static_simple_vector.h"
+#include "simple_vector_arena.h"
+#include "aligned_allocator.h"
+#include "soa_simple_vector.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 
@@ -32,6 +62,129 @@ private:
     size_t x_;
 };
 
+// Считает вызовы конструкторов и деструктора
+struct Counted {
+    static inline size_t constructed = 0;
+    static inline size_t destroyed = 0;
+
+    Counted() {
+        ++constructed;
+    }
+    Counted(const Counted&) {
+        ++constructed;
+    }
+    Counted(Counted&&) noexcept {
+        ++constructed;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() {
+        ++destroyed;
+    }
+
+    static void Reset() {
+        constructed = 0;
+        destroyed = 0;
+    }
+};
+
+// Владеющий дескриптор без указателей на себя: переносится побайтово
+class Handle {
+public:
+    static inline atomic<size_t> live = 0; // Handle создаются и из потоков сборщика
+
+    explicit Handle(int value)
+        : value_(make_unique<int>(value)) {
+        ++live;
+    }
+    Handle(Handle&& other) noexcept = default;
+    Handle& operator=(Handle&& other) noexcept {
+        if (value_ != nullptr) {
+            --live;
+        }
+        value_ = std::move(other.value_);
+        return *this;
+    }
+    ~Handle() {
+        if (value_ != nullptr) {
+            --live;
+        }
+    }
+
+    int Get() const {
+        return *value_;
+    }
+
+private:
+    unique_ptr<int> value_;
+};
+
+template <>
+struct IsTriviallyRelocatable<Handle> : std::true_type {};
+
+// Копируемый тип, чьё перемещение может бросить исключение
+struct ThrowingMove {
+    static inline size_t copies = 0;
+    static inline size_t moves = 0;
+
+    ThrowingMove() = default;
+    ThrowingMove(const ThrowingMove&) {
+        ++copies;
+    }
+    ThrowingMove(ThrowingMove&&) {
+        ++moves;
+    }
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+    ThrowingMove& operator=(ThrowingMove&&) = default;
+};
+
+// Тип без конструктора по умолчанию
+class NoDefault {
+public:
+    explicit NoDefault(int value)
+        : value_(value) {
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+private:
+    int value_;
+};
+
+// Аллокатор со счётчиком выделений; экземпляры с разными счётчиками не равны
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(size_t* allocations)
+        : allocations(allocations) {
+    }
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept
+        : allocations(other.allocations) {
+    }
+
+    T* allocate(size_t n) {
+        ++*allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& other) const noexcept {
+        return allocations == other.allocations;
+    }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+    size_t* allocations;
+};
+
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
     iota(v.begin(), v.end(), 1);
@@ -150,6 +303,1502 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+void TestReserveDoesNotConstruct() {
+    cout << "Test reserve does not construct elements"s << endl;
+    Counted::Reset();
+    {
+        SimpleVector<Counted> v(Reserve(1000));
+        assert(v.GetCapacity() == 1000);
+        assert(Counted::constructed == 0);
+
+        v.Reserve(100000);
+        assert(Counted::constructed == 0);
+
+        v.Resize(3);
+        assert(Counted::constructed == 3);
+        v.PopBack();
+        assert(Counted::destroyed == 1);
+    }
+    assert(Counted::constructed == Counted::destroyed);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestNoDefaultConstructible() {
+    cout << "Test type without default constructor"s << endl;
+    SimpleVector<NoDefault> v;
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(NoDefault(i));
+    }
+    const NoDefault front = v[0];
+    v.Insert(v.begin(), front);
+    v.PushBack(v[1]);
+    assert(v.GetSize() == 12);
+    assert(v[0].GetValue() == 0 && v[1].GetValue() == 0 && v[11].GetValue() == 0);
+    v.Erase(v.begin());
+    assert(v.GetSize() == 11);
+    assert(v[10].GetValue() == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace"s << endl;
+    SimpleVector<X> v;
+    for (size_t i = 0; i < 5; ++i) {
+        X& x = v.EmplaceBack(i);
+        assert(x.GetX() == i);
+    }
+    auto it = v.Emplace(v.begin() + 2, 42);
+    assert(it == v.begin() + 2 && it->GetX() == 42);
+    assert(v.GetSize() == 6 && v[5].GetX() == 4);
+
+    Counted::Reset();
+    SimpleVector<Counted> counted(Reserve(4));
+    counted.EmplaceBack();
+    counted.Emplace(counted.end());
+    assert(Counted::constructed == 2);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRelocation() {
+    cout << "Test relocation on growth"s << endl;
+    SimpleVector<int> ints = GenerateVector(1000);
+    ints.Reserve(5000);
+    ints.Insert(ints.begin() + 10, -1);
+    ints.Erase(ints.begin());
+    assert(ints.GetSize() == 1000);
+    assert(ints[8] == 10 && ints[9] == -1 && ints[10] == 11 && ints[999] == 1000);
+
+    // Перемещение не noexcept: при росте буфера элементы копируются
+    SimpleVector<ThrowingMove> v(4);
+    ThrowingMove::copies = 0;
+    ThrowingMove::moves = 0;
+    v.Reserve(8);
+    assert(ThrowingMove::copies == 4 && ThrowingMove::moves == 0);
+
+    // Некопируемый X переносится перемещением
+    SimpleVector<X> xs(3);
+    xs.Reserve(10);
+    assert(xs[2].GetX() == 5);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAllocator() {
+    cout << "Test custom allocator"s << endl;
+    size_t first_count = 0;
+    size_t second_count = 0;
+    using Alloc = CountingAllocator<int>;
+    SimpleVector<int, Alloc> first(Reserve(100), Alloc(&first_count));
+    for (int i = 0; i < 100; ++i) {
+        first.PushBack(i);
+    }
+    assert(first_count == 1);
+
+    SimpleVector<int, Alloc> copy(first);
+    assert(first_count == 2 && copy == first);
+
+    // Аллокаторы не равны и не распространяются: элементы переносятся в память второго
+    SimpleVector<int, Alloc> second{Alloc(&second_count)};
+    second = std::move(first);
+    assert(second_count == 1 && second.GetAllocator() == Alloc(&second_count));
+    assert(second == copy && first.IsEmpty());
+
+    SimpleVector<int, Alloc> moved(std::move(second));
+    assert(moved.GetAllocator() == Alloc(&second_count) && moved.GetSize() == 100);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSmallSimpleVector() {
+    cout << "Test small simple vector"s << endl;
+    using Small = SmallSimpleVector<string, 4>;
+    Small v;
+    for (int i = 0; i < 4; ++i) {
+        v.PushBack(to_string(i));
+    }
+    assert(v.IsInline() && v.GetCapacity() == 4);
+    v.Insert(v.begin(), "front"s);
+    assert(!v.IsInline() && v.GetSize() == 5 && v[0] == "front"s && v[4] == "3"s);
+    v.Erase(v.begin());
+    assert(v[0] == "0"s);
+
+    Small inline_vector = {"a"s, "b"s};
+    Small heap_vector = v;
+    inline_vector.swap(heap_vector);
+    assert(inline_vector == v && heap_vector.GetSize() == 2 && heap_vector[1] == "b"s);
+    assert(inline_vector < heap_vector);
+
+    Small moved(std::move(heap_vector));
+    assert(moved.IsInline() && moved.GetSize() == 2 && heap_vector.IsEmpty());
+    moved = std::move(inline_vector);
+    assert(moved == v && inline_vector.IsEmpty());
+
+    SmallSimpleVector<X, 2> noncopyable(Reserve(8));
+    noncopyable.EmplaceBack(1);
+    noncopyable.EmplaceBack(2);
+    SmallSimpleVector<X, 2> noncopyable_moved(std::move(noncopyable));
+    assert(noncopyable_moved[1].GetX() == 2);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestGrowthPolicy() {
+    cout << "Test growth policy"s << endl;
+    size_t allocations = 0;
+    using Alloc = CountingAllocator<int>;
+    SimpleVector<int, Alloc> v{Alloc(&allocations)};
+    for (size_t i = 1; i <= 1024; ++i) {
+        v.Resize(i);
+    }
+    assert(v.GetSize() == 1024 && allocations == 11);
+
+    SimpleVector<int, std::allocator<int>, GoldenGrowth> golden(Reserve(10));
+    golden.Resize(10);
+    golden.PushBack(1);
+    assert(golden.GetCapacity() == 15);
+
+    SimpleVector<char, std::allocator<char>, PageRoundedGrowth<4096>> paged(3);
+    paged.PushBack('a');
+    assert(paged.GetCapacity() == 8);
+    paged.Resize(3000);
+    assert(paged.GetCapacity() == 4096);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestShrink() {
+    cout << "Test shrink to fit"s << endl;
+    SimpleVector<int> v = GenerateVector(100);
+    v.Reserve(1000);
+    assert(v.TrimTo(500) == 500 * sizeof(int) && v.GetCapacity() == 500);
+    assert(v.TrimTo(10) == 400 * sizeof(int) && v.GetCapacity() == 100);
+    assert(v.TrimTo(200) == 0 && v.GetCapacity() == 100);
+    v.Resize(40);
+    assert(v.ShrinkToFit() == 60 * sizeof(int) && v.GetCapacity() == 40);
+    assert(v[0] == 1 && v[39] == 40);
+
+    assert(v.ClearAndRelease() == 40 * sizeof(int));
+    assert(v.IsEmpty() && v.GetCapacity() == 0 && v.begin() == nullptr);
+    assert(v.ShrinkToFit() == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestRangeOperations() {
+    cout << "Test range operations"s << endl;
+    const SimpleVector<int> source = {1, 2, 3, 4, 5};
+
+    SimpleVector<int> ints;
+    ints.Append(source.begin(), source.end());
+    ints.InsertRange(ints.begin() + 1, source.begin(), source.begin() + 2);
+    assert((ints == SimpleVector<int>{1, 1, 2, 2, 3, 4, 5}));
+    ints.Reserve(20);
+    ints.InsertRange(ints.begin() + 2, source.begin(), source.end());
+    assert((ints == SimpleVector<int>{1, 1, 1, 2, 3, 4, 5, 2, 2, 3, 4, 5}));
+    auto it = ints.EraseRange(ints.begin() + 2, ints.begin() + 7);
+    assert(*it == 2 && (ints == SimpleVector<int>{1, 1, 2, 2, 3, 4, 5}));
+
+    // Нетривиальный тип: хвост длиннее и короче вставки, вставка с ростом
+    SimpleVector<string> strings(Reserve(32));
+    const SimpleVector<string> words = {"a"s, "b"s, "c"s};
+    strings.Assign(words.begin(), words.end());
+    strings.InsertRange(strings.begin() + 1, words.begin(), words.begin() + 1);
+    assert((strings == SimpleVector<string>{"a"s, "a"s, "b"s, "c"s}));
+    strings.InsertRange(strings.begin() + 3, words.begin(), words.end());
+    assert((strings == SimpleVector<string>{"a"s, "a"s, "b"s, "a"s, "b"s, "c"s, "c"s}));
+    strings.ShrinkToFit();
+    strings.InsertRange(strings.end(), words.begin(), words.end());
+    assert(strings.GetSize() == 10 && strings[9] == "c"s);
+    strings.Assign(words.begin(), words.begin() + 2);
+    assert((strings == SimpleVector<string>{"a"s, "b"s}));
+
+    // Входной итератор без известной длины
+    istringstream input("7 8 9");
+    ints.InsertRange(ints.begin(), istream_iterator<int>(input), istream_iterator<int>());
+    assert(ints.GetSize() == 10 && ints[0] == 7 && ints[2] == 9 && ints[3] == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestStats() {
+    cout << "Test allocation stats"s << endl;
+    static_assert(sizeof(SimpleVector<int>) == sizeof(size_t) + sizeof(int*) + sizeof(size_t));
+
+    SimpleVector<string, std::allocator<string>, DoublingGrowth, VectorStats> v;
+    for (int i = 0; i < 8; ++i) {
+        v.PushBack(to_string(i));
+    }
+    v.Insert(v.begin(), "x"s);
+    v.Reserve(100);
+    v.Resize(50);
+    v.PopBack();
+    v.ShrinkToFit();
+
+    const VectorStatsSnapshot stats = v.GetStats();
+    assert(stats.allocations == 7);
+    assert(stats.GetReallocations(GrowthSite::kPushBack) == 3);
+    assert(stats.GetReallocations(GrowthSite::kInsert) == 1);
+    assert(stats.GetReallocations(GrowthSite::kReserve) == 1);
+    assert(stats.GetReallocations(GrowthSite::kShrink) == 1);
+    assert(stats.GetReallocations(GrowthSite::kResize) == 0);
+    assert(stats.elements_moved == 1 + 2 + 4 + 8 + 9 + 49);
+    assert(stats.elements_copied == 0 && stats.elements_relocated_bitwise == 0);
+    assert(stats.peak_size == 50 && stats.peak_capacity == 100);
+
+    SimpleVector<int> plain = GenerateVector(10);
+    assert(plain.GetStats().allocations == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+// Сверяет сравнения и поиск SimpleVector<T> с алгоритмами стандартной библиотеки
+template <typename T>
+void CheckKernelsAgainstStd(mt19937& rng) {
+    uniform_int_distribution<int> value_dist(0, 3);
+    for (size_t size = 0; size < 100; ++size) {
+        SimpleVector<T> lhs;
+        for (size_t i = 0; i < size; ++i) {
+            lhs.PushBack(static_cast<T>(value_dist(rng)));
+        }
+        SimpleVector<T> rhs = lhs;
+        if (size > 0 && value_dist(rng) != 0) {
+            rhs[rng() % size] = static_cast<T>(value_dist(rng));
+        }
+        if (value_dist(rng) == 0) {
+            rhs.PushBack(static_cast<T>(1));
+        }
+
+        const bool expected_equal = lhs.GetSize() == rhs.GetSize() && equal(lhs.begin(), lhs.end(), rhs.begin());
+        assert((lhs == rhs) == expected_equal);
+        assert((lhs < rhs) == lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+        assert((rhs < lhs) == lexicographical_compare(rhs.begin(), rhs.end(), lhs.begin(), lhs.end()));
+
+        const T needle = static_cast<T>(value_dist(rng));
+        assert(lhs.Find(needle) == find(lhs.cbegin(), lhs.cend(), needle));
+        assert(lhs.Count(needle) == static_cast<size_t>(count(lhs.begin(), lhs.end(), needle)));
+        assert(lhs.Contains(needle) == (find(lhs.begin(), lhs.end(), needle) != lhs.end()));
+    }
+}
+
+void TestComparisonKernels() {
+    cout << "Test comparison and search kernels"s << endl;
+    mt19937 rng(42);
+    CheckKernelsAgainstStd<uint8_t>(rng);
+    CheckKernelsAgainstStd<int8_t>(rng);
+    CheckKernelsAgainstStd<int16_t>(rng);
+    CheckKernelsAgainstStd<uint32_t>(rng);
+    CheckKernelsAgainstStd<int64_t>(rng);
+    CheckKernelsAgainstStd<float>(rng);
+    CheckKernelsAgainstStd<double>(rng);
+
+    // Знаковые байты и отрицательные числа упорядочиваются по значению, а не по представлению
+    assert((SimpleVector<int8_t>{-1} < SimpleVector<int8_t>{1}));
+    assert((SimpleVector<int>{1, -5} < SimpleVector<int>{1, 3}));
+
+    const SimpleVector<string> words = {"a"s, "b"s, "b"s};
+    assert(words.Count("b"s) == 2 && words.Find("b"s) == words.begin() + 1 && !words.Contains("c"s));
+    cout << "Done!"s << endl << endl;
+}
+
+// Бросает исключение, когда copies_left доходит до нуля
+struct ThrowingCopy {
+    static inline std::atomic<int> copies_left = 0;
+
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy&)
+        : payload(make_unique<int>(1)) {
+        if (--copies_left == 0) {
+            throw runtime_error("copy failed");
+        }
+    }
+
+    unique_ptr<int> payload;
+};
+
+void TestParallelAlgorithms() {
+    cout << "Test parallel algorithms"s << endl;
+    ParallelPool pool(4);
+    ParallelOptions options;
+    options.pool = &pool;
+    options.serial_threshold = 1000;
+    options.min_chunk_bytes = 256;
+
+    const size_t size = 100003;
+    SimpleVector<int> v;
+    ParallelFill(v, size, 3, options);
+    assert(v.GetSize() == size && v.Count(3) == size);
+
+    ParallelForEach(v, [](int& x) {
+        x += 1;
+    }, options);
+    SimpleVector<long long> squares;
+    ParallelTransform(v, squares, [](int x) {
+        return static_cast<long long>(x) * x;
+    }, options);
+    assert(squares.GetSize() == size && squares[size - 1] == 16);
+
+    iota(v.begin(), v.end(), 0);
+    const long long expected = static_cast<long long>(size) * (size - 1) / 2;
+    assert(ParallelReduce(v, 0LL, std::plus<>(), options) == expected);
+    ParallelTransformInPlace(v, [](int x) {
+        return -x;
+    }, options);
+    assert(ParallelReduce(v, 0LL, std::plus<>(), options) == -expected);
+
+    // Ниже порога всё выполняется в вызывающем потоке
+    SimpleVector<string> small_strings;
+    ParallelFill(small_strings, 10, "abc"s, options);
+    assert(small_strings.GetSize() == 10 && small_strings[9] == "abc"s);
+
+    // Ошибка в одном чанке откатывает все созданные элементы
+    SimpleVector<ThrowingCopy> throwing;
+    ThrowingCopy::copies_left = 50000;
+    try {
+        ParallelFill(throwing, size, ThrowingCopy(), options);
+        assert(false);
+    }
+    catch (const runtime_error&) {
+    }
+    assert(throwing.IsEmpty());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestConcurrentSimpleVector() {
+    cout << "Test concurrent simple vector"s << endl;
+    const size_t threads = 4;
+    const size_t per_thread = 20000;
+    ConcurrentSimpleVector<size_t> v;
+    const size_t& first = v.EmplaceBack(0);
+
+    vector<thread> producers;
+    for (size_t t = 0; t < threads; ++t) {
+        producers.emplace_back([&v, t] {
+            for (size_t i = 0; i < per_thread; ++i) {
+                const size_t& pushed = v.EmplaceBack(t * per_thread + i + 1);
+                assert(pushed == t * per_thread + i + 1);
+            }
+        });
+    }
+    for (thread& producer : producers) {
+        producer.join();
+    }
+    assert(v.GetSize() == threads * per_thread + 1);
+    assert(&first == &v[0]); // Ссылки не сдвигаются при росте
+
+    SimpleVector<size_t> frozen = v.Freeze();
+    assert(v.IsEmpty() && frozen.GetSize() == threads * per_thread + 1);
+    sort(frozen.begin(), frozen.end());
+    for (size_t i = 0; i < frozen.GetSize(); ++i) {
+        assert(frozen[i] == i);
+    }
+
+    // Слот, чей конструктор бросил исключение, пропускается
+    ConcurrentSimpleVector<ThrowingCopy> throwing;
+    ThrowingCopy::copies_left = 40;
+    const ThrowingCopy prototype;
+    for (int i = 0; i < 100; ++i) {
+        try {
+            throwing.PushBack(prototype);
+        }
+        catch (const runtime_error&) {
+        }
+    }
+    assert(throwing.GetSize() == 100);
+    SimpleVector<ThrowingCopy> frozen_throwing = throwing.Freeze();
+    assert(frozen_throwing.GetSize() == 99 && *frozen_throwing[98].payload == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSimpleVectorCollector() {
+    cout << "Test simple vector collector"s << endl;
+    ParallelPool pool(4);
+    ParallelOptions options;
+    options.pool = &pool;
+    options.serial_threshold = 100;
+    options.min_chunk_bytes = 64;
+
+    const size_t threads = 4;
+    const size_t per_thread = 5000;
+    SimpleVectorCollector<string> collector;
+    for (int round = 0; round < 2; ++round) {
+        vector<thread> producers;
+        for (size_t t = 0; t < threads; ++t) {
+            producers.emplace_back([&collector, t] {
+                for (size_t i = 0; i < per_thread; ++i) {
+                    collector.PushBack(to_string(t * per_thread + i));
+                }
+            });
+        }
+        for (thread& producer : producers) {
+            producer.join();
+        }
+        assert(collector.GetSize() == threads * per_thread);
+
+        SimpleVector<string> merged{"head"s};
+        collector.CollectInto(merged, options);
+        assert(merged.GetSize() == threads * per_thread + 1 && merged[0] == "head"s);
+        assert(collector.GetSize() == 0);
+        SimpleVector<size_t> values(Reserve(threads * per_thread));
+        for (size_t i = 1; i < merged.GetSize(); ++i) {
+            values.PushBack(stoul(merged[i]));
+        }
+        sort(values.begin(), values.end());
+        for (size_t i = 0; i < values.GetSize(); ++i) {
+            assert(values[i] == i);
+        }
+    }
+
+    // Тривиальные элементы переносятся побайтово; порядок внутри шарда сохраняется
+    SimpleVectorCollector<int> local;
+    for (int i = 0; i < 1000; ++i) {
+        local.PushBack(i);
+    }
+    assert(local.GetShardCount() == 1);
+    SimpleVector<int> collected = local.Collect(options);
+    assert(collected.GetSize() == 1000 && is_sorted(collected.begin(), collected.end()));
+    assert(local.Collect().IsEmpty());
+
+    // Тип, помеченный IsTriviallyRelocatable, переносится memcpy, и шард не должен разрушать
+    // его исходные копии: иначе unique_ptr внутри Handle освобождался бы дважды
+    {
+        SimpleVectorCollector<Handle> handles;
+        SimpleVector<Handle> merged;
+        for (int round = 0; round < 2; ++round) {
+            vector<thread> producers;
+            for (int t = 0; t < 2; ++t) {
+                producers.emplace_back([&handles, t] {
+                    for (int i = 0; i < 500; ++i) {
+                        handles.EmplaceBack(t * 500 + i);
+                    }
+                });
+            }
+            for (thread& producer : producers) {
+                producer.join();
+            }
+            handles.CollectInto(merged, options);
+            assert(handles.GetSize() == 0 && Handle::live == merged.GetSize());
+        }
+        assert(merged.GetSize() == 2000);
+        long long sum = 0;
+        for (const Handle& handle : merged) {
+            sum += handle.Get();
+        }
+        assert(sum == 2 * 999 * 1000 / 2);
+    }
+    assert(Handle::live == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+struct Record {
+    uint64_t id;
+    double score;
+};
+
+void TestMappedSimpleVector() {
+    cout << "Test mapped simple vector"s << endl;
+    const string path = "simple_vector_mapped_test.bin"s;
+    remove(path.c_str());
+    {
+        MappedSimpleVector<Record> v(path);
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        for (uint64_t i = 0; i < 10000; ++i) {
+            v.PushBack({i, i * 0.5});
+        }
+        v.PushBack(v[0]); // Значение из самого отображения переживает mremap
+        v.PopBack();
+        v.Resize(10001);
+        assert(v[10000].id == 0 && v[10000].score == 0.0);
+        v.Sync();
+    }
+    {
+        // Повторное открытие читает данные прямо из файла
+        MappedSimpleVector<Record> v(path);
+        assert(v.GetSize() == 10001 && v.GetCapacity() >= 10001);
+        for (uint64_t i = 0; i < 10000; ++i) {
+            assert(v[i].id == i && v[i].score == i * 0.5);
+        }
+        MappedSimpleVector<Record> moved(std::move(v));
+        assert(moved.At(9999).id == 9999);
+        try {
+            moved.At(10001);
+            assert(false);
+        }
+        catch (const out_of_range&) {
+        }
+
+        // Перемещённый вектор пуст: чтение и Clear безопасны, рост без файла бросает
+        assert(v.IsEmpty() && v.GetCapacity() == 0 && v.begin() == v.end());
+        v.Clear();
+        v.Resize(0);
+        v.Sync();
+        try {
+            v.PushBack({1, 1.0});
+            assert(false);
+        }
+        catch (const logic_error&) {
+        }
+        v = std::move(moved);
+        assert(v.GetSize() == 10001 && v[5].id == 5);
+    }
+    {
+        // Файл с другим размером элемента отвергается
+        try {
+            MappedSimpleVector<uint32_t> wrong(path);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+    }
+    remove(path.c_str());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSerialization() {
+    cout << "Test serialization"s << endl;
+    {
+        // Сырой формат и поэлементный формат через потоки
+        SimpleVector<Record> records;
+        for (uint64_t i = 0; i < 1001; ++i) {
+            records.PushBack({i, i * 2.0});
+        }
+        SimpleVector<string> words{"alpha"s, ""s, string(100, 'x')};
+        SimpleVector<SimpleVector<int>> nested{{1, 2, 3}, {}, {4}};
+
+        stringstream stream;
+        WriteTo(stream, records);
+        WriteTo(stream, words);
+        WriteTo(stream, nested);
+
+        SimpleVector<Record> records_read{Record{7, 7.0}};
+        SimpleVector<string> words_read;
+        SimpleVector<SimpleVector<int>> nested_read;
+        ReadFrom(stream, records_read);
+        ReadFrom(stream, words_read);
+        ReadFrom(stream, nested_read);
+        assert(records_read.GetSize() == records.GetSize());
+        for (size_t i = 0; i < records.GetSize(); ++i) {
+            assert(records_read[i].id == records[i].id && records_read[i].score == records[i].score);
+        }
+        assert(words_read == words && nested_read == nested);
+
+        // Вектор другого типа и обрезанные данные отвергаются
+        stringstream mismatch;
+        WriteTo(mismatch, records);
+        SimpleVector<int> wrong;
+        try {
+            ReadFrom(mismatch, wrong);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+        stringstream truncated(stream.str().substr(0, 100));
+        try {
+            ReadFrom(truncated, records_read);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+    }
+    {
+        // Несколько векторов одним writev, чтение из дескриптора и просмотр без копирования
+        const string path = "simple_vector_io_test.bin"s;
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        SimpleVector<int> ints{1, 2, 3};
+        SimpleVector<Record> records{Record{1, 0.5}, Record{2, 1.5}};
+        SimpleVector<char> empty;
+        WriteVectors(fd, ints, records, empty);
+
+        ::lseek(fd, 0, SEEK_SET);
+        SimpleVector<int> ints_read;
+        SimpleVector<Record> records_read;
+        SimpleVector<char> empty_read{'z'};
+        ReadFrom(fd, ints_read);
+        ReadFrom(fd, records_read);
+        ReadFrom(fd, empty_read);
+        assert(ints_read == ints && records_read[1].id == 2 && empty_read.IsEmpty());
+
+        const size_t bytes = static_cast<size_t>(::lseek(fd, 0, SEEK_END));
+        SimpleVector<uint64_t> buffer(bytes / sizeof(uint64_t) + 1); // Выровненный буфер
+        ::lseek(fd, 0, SEEK_SET);
+        ReadAll(fd, buffer.begin(), bytes);
+        ::close(fd);
+        remove(path.c_str());
+
+        size_t offset = 0;
+        size_t consumed = 0;
+        const auto* raw = reinterpret_cast<const char*>(buffer.begin());
+        SimpleVectorView<const int> ints_view = ReadView<int>(raw, bytes, &consumed);
+        assert(ints_view.GetSize() == 3 && ints_view[2] == 3);
+        assert(static_cast<const void*>(ints_view.Data()) == raw + sizeof(SerializedVectorHeader));
+        offset += consumed;
+        SimpleVectorView<const Record> records_view = ReadView<Record>(raw + offset, bytes - offset, &consumed);
+        assert(records_view.GetSize() == 2 && records_view[0].score == 0.5);
+        offset += consumed;
+        assert(ReadView<char>(raw + offset, bytes - offset, &consumed).IsEmpty());
+        assert(offset + consumed == bytes);
+        try {
+            ReadView<int>(raw, sizeof(SerializedVectorHeader) + 4);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+// Сумма элементов без копирования диапазона
+long long SumView(ConstSimpleVectorView<int> view) {
+    return accumulate(view.begin(), view.end(), 0LL);
+}
+
+void TestSimpleVectorView() {
+    cout << "Test simple vector view"s << endl;
+    SimpleVector<int> v(100);
+    iota(v.begin(), v.end(), 0);
+    assert(SumView(v) == 4950); // Неявное преобразование
+
+    SimpleVectorView<int> all = v;
+    SimpleVectorView<int> middle = all.Subview(10, 5);
+    assert(middle.GetSize() == 5 && middle[0] == 10 && middle.Data() == v.begin() + 10);
+    middle[0] = -1; // Изменяемое представление пишет в вектор
+    assert(v[10] == -1);
+    v[10] = 10;
+    assert(all.Subview(95).GetSize() == 5 && all.Subview(100).IsEmpty());
+    assert(all.First(3).GetSize() == 3 && all.Last(2)[0] == 98 && all.Last(0).IsEmpty());
+    assert(SumView(all.First(10)) == 45);
+
+    // Нарезка и At проверяют границы
+    for (auto bad : {function<void()>([&] { all.Subview(101); }),
+                     function<void()>([&] { all.First(101); }),
+                     function<void()>([&] { all.Last(101); }),
+                     function<void()>([&] { all.At(100); })}) {
+        try {
+            bad();
+            assert(false);
+        }
+        catch (const out_of_range&) {
+        }
+    }
+
+    // Сравнения с векторами и представлениями
+    const SimpleVector<int> prefix{0, 1, 2};
+    ConstSimpleVectorView<int> first_three = all.First(3);
+    assert(first_three == prefix && prefix == first_three && all.First(3) == first_three);
+    assert(first_three < all && all.Subview(1) > all);
+    assert(first_three != all.Last(3) && first_three <= prefix && first_three >= prefix);
+
+    assert(all.Contains(42) && all.Find(42) == v.begin() + 42 && all.Count(7) == 1);
+    assert(!first_three.Contains(42) && first_three.Find(42) == first_three.end());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestCowSimpleVector() {
+    cout << "Test copy-on-write simple vector"s << endl;
+    CowSimpleVector<int> table{1, 2, 3, 4};
+    CowSimpleVector<int> snapshot = table;
+    assert(snapshot.IsShared() && snapshot.cbegin() == table.cbegin()); // Копия без копирования буфера
+
+    // Первая запись отделяет буфер, остальные копии не меняются
+    snapshot.PushBack(5);
+    assert(!snapshot.IsShared() && !table.IsShared());
+    assert(snapshot.GetSize() == 5 && table.GetSize() == 4 && snapshot != table);
+    const int* detached = snapshot.cbegin();
+    snapshot.PushBack(6); // Копия получила запас ёмкости
+    assert(snapshot.cbegin() == detached);
+
+    CowSimpleVector<int> other = table;
+    other.Set(0, 100);
+    other.Insert(other.cbegin() + 1, 50);
+    other.Erase(other.cend() - 1);
+    assert(other == CowSimpleVector<int>({100, 50, 2, 3}) && table == CowSimpleVector<int>({1, 2, 3, 4}));
+    CowSimpleVector<int> resized = table;
+    resized.Resize(2);
+    resized.PopBack();
+    assert(resized.GetSize() == 1 && table.GetSize() == 4 && resized < table);
+
+    // После выдачи изменяемой ссылки копии глубокие: запись по ней не видна в копии
+    int& first = table[0];
+    CowSimpleVector<int> deep = table;
+    first = 42;
+    assert(deep[0] == 1 && table[0] == 42 && !table.IsShared());
+
+    // Очистка разделяемого вектора не копирует буфер
+    CowSimpleVector<int> cleared = deep;
+    cleared.Clear();
+    assert(cleared.IsEmpty() && deep.GetSize() == 4 && !deep.IsShared());
+    assert(deep.View() == SimpleVector<int>({1, 2, 3, 4}) && deep.Contains(3) && deep.Count(5) == 0);
+
+    // Снимки передаются в другие потоки
+    CowSimpleVector<string> routes(1000, "route"s);
+    vector<thread> workers;
+    atomic<size_t> total = 0;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([snapshot = routes, &total, t]() mutable {
+            for (int i = 0; i < 100; ++i) {
+                CowSimpleVector<string> local = snapshot;
+                total += local.GetSize();
+            }
+            if (t == 0) {
+                snapshot.PushBack("mine"s);
+            }
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    assert(total == 400000 && routes.GetSize() == 1000 && !routes.IsShared());
+    cout << "Done!"s << endl << endl;
+}
+
+// Таблица квадратов, собранная на этапе компиляции
+constexpr StaticSimpleVector<int, 16> MakeSquares() {
+    StaticSimpleVector<int, 16> squares;
+    for (int i = 0; i < 10; ++i) {
+        squares.PushBack(i * i);
+    }
+    squares.Insert(squares.begin(), -1);
+    squares.Erase(squares.begin() + 1);
+    return squares;
+}
+
+void TestStaticSimpleVector() {
+    cout << "Test static simple vector"s << endl;
+    constexpr StaticSimpleVector<int, 16> squares = MakeSquares();
+    static_assert(squares.GetSize() == 10 && squares[0] == -1 && squares[9] == 81);
+    static_assert(squares.At(3) == 9 && StaticSimpleVector<int, 16>::GetCapacity() == 16);
+    static_assert(squares > StaticSimpleVector<int, 16>{-1, 1, 4} && squares != StaticSimpleVector<int, 16>{});
+    static_assert(sizeof(StaticSimpleVector<char, 8>) <= 16); // Без кучи и указателей
+
+    // Во время выполнения сравнения идут через векторные ядра
+    StaticSimpleVector<int, 16> copy = squares;
+    assert(copy == squares && !(copy < squares));
+    copy.Resize(12);
+    assert(copy[11] == 0 && copy > squares);
+
+    // Политики переполнения
+    StaticSimpleVector<string, 2, FailOnOverflow> fail{"a"s, "b"s};
+    assert(fail.IsFull() && !fail.PushBack("c"s) && fail.Insert(fail.begin(), "c"s) == fail.end());
+    assert(!fail.Resize(3) && fail.GetSize() == 2 && fail[1] == "b"s);
+    fail.PopBack();
+    assert(fail.PushBack("c"s) && fail[1] == "c"s);
+
+    StaticSimpleVector<int, 1, ThrowOnOverflow> throwing{1};
+    try {
+        throwing.PushBack(2);
+        assert(false);
+    }
+    catch (const length_error&) {
+    }
+
+    StaticSimpleVector<string, 4> a{"x"s, "y"s};
+    StaticSimpleVector<string, 4> b{"z"s};
+    a.swap(b);
+    assert(a.GetSize() == 1 && a[0] == "z"s && b.GetSize() == 2 && b[1] == "y"s);
+    try {
+        a.At(1);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSimpleVectorArena() {
+    cout << "Test simple vector arena"s << endl;
+    SimpleVectorArena arena(1024);
+    {
+        // Вектор, выделявший последним, растёт на месте
+        ArenaSimpleVector<int> v{ArenaAllocator<int>(arena)};
+        v.PushBack(0);
+        const int* first = v.begin();
+        for (int i = 1; i < 200; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.begin() == first && v.GetCapacity() >= 200 && arena.GetBlockCount() == 1);
+        v.Resize(250);
+        assert(v.begin() == first && v[199] == 199 && v[249] == 0);
+
+        // Чередование векторов: рост переносит элементы, как обычно
+        ArenaSimpleVector<string> words{ArenaAllocator<string>(arena)};
+        for (int i = 0; i < 100; ++i) {
+            words.PushBack(to_string(i));
+            v.PushBack(i);
+        }
+        assert(words[99] == "99"s && v.GetSize() == 350 && v[349] == 99);
+        assert(arena.GetBlockCount() > 1);
+
+        // Перемещающее присваивание забирает буфер вместе с ареной
+        SimpleVectorArena other_arena;
+        ArenaSimpleVector<int> other{ArenaAllocator<int>(other_arena)};
+        const int* buffer = v.begin();
+        other = std::move(v);
+        assert(other.begin() == buffer && other.GetAllocator() == ArenaAllocator<int>(arena));
+    }
+    assert(arena.GetBytesAllocated() > 0);
+    arena.Reset();
+    assert(arena.GetBytesAllocated() == 0 && arena.GetBlockCount() == 1);
+
+    // После Reset память переиспользуется без новых блоков
+    ArenaSimpleVector<int> reused(100, 7, ArenaAllocator<int>(arena));
+    assert(reused.Count(7) == 100 && arena.GetBlockCount() == 1);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAlignedStorage() {
+    cout << "Test aligned storage"s << endl;
+    AlignedSimpleVector<float> v;
+    assert(v.IsAligned(64));
+    for (int i = 0; i < 100; ++i) {
+        v.PushBack(static_cast<float>(i));
+        assert(v.IsAligned(64) && v.GetCapacity() * sizeof(float) % 64 == 0);
+    }
+
+    const float* aligned = v.AssumeAligned<64>();
+    assert(aligned == v.begin());
+    float sum = 0;
+    for (size_t i = 0; i < v.GetSize(); ++i) {
+        sum += aligned[i];
+    }
+    assert(sum == 4950.0f);
+
+    // Копии и перевыделения сохраняют выравнивание
+    AlignedSimpleVector<float> copy = v;
+    assert(copy.GetCapacity() == 112); // 100 float округляются до 7 кэш-линий
+    copy.Resize(1000);
+    assert(copy.GetCapacity() == 1008 && copy.ShrinkToFit() == 0); // Хвост округления не освобождается
+    copy.Resize(500);
+    assert(copy.ShrinkToFit() == (1008 - 512) * sizeof(float) && copy.GetCapacity() == 512);
+    assert(copy.IsAligned(64) && copy[99] == 99.0f);
+
+    // Ёмкость округлена на любом пути выделения, не только при росте
+    AlignedSimpleVector<double, 32> narrow(Reserve(3));
+    narrow.PushBack(1.0);
+    assert(narrow.IsAligned(32) && narrow.GetCapacity() == 4);
+    narrow.Reserve(5);
+    assert(narrow.GetCapacity() == 8);
+    AlignedSimpleVector<double, 32> sized(5);
+    assert(sized.GetCapacity() == 8);
+
+    SimpleVector<double> plain{1.0};
+    assert(plain.IsAligned(alignof(double)));
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSoASimpleVector() {
+    cout << "Test structure-of-arrays simple vector"s << endl;
+    SoASimpleVector<float, float, string> particles;
+    for (int i = 0; i < 100; ++i) {
+        particles.PushBack({static_cast<float>(i), 1.0f, to_string(i)});
+    }
+    particles.EmplaceBack(100.0f, 1.0f, "last"s);
+    particles.PushBack(particles[0]); // Строка из самого вектора переживает перевыделение
+    assert(particles.GetSize() == 102 && get<2>(particles[101]) == "0"s);
+
+    // Столбцы непрерывны и идут через векторные ядра
+    SimpleVectorView<float> xs = particles.Column<0>();
+    assert(xs.GetSize() == 102 && xs.Count(1.0f) == 1 && particles.Column<1>().Count(1.0f) == 102);
+    assert(&particles.Column<0>()[1] == &particles.Column<0>()[0] + 1);
+
+    // Существующие циклы работают через кортеж ссылок
+    for (auto [x, y, name] : particles) {
+        x += y;
+        name += "!"s;
+    }
+    assert(get<0>(particles[5]) == 6.0f && get<2>(particles[5]) == "5!"s);
+    float sum = 0;
+    for (auto it = particles.cbegin(); it != particles.cend(); ++it) {
+        sum += get<1>(*it);
+    }
+    assert(sum == 102.0f && particles.end() - particles.begin() == 102);
+    particles[0] = make_tuple(-1.0f, -1.0f, "first"s);
+    assert(get<2>(particles.At(0)) == "first"s);
+
+    auto copy = particles;
+    assert(copy == particles);
+    copy.PopBack();
+    assert(copy != particles);
+    copy.Resize(200);
+    assert(copy.GetSize() == 200 && get<2>(copy[199]).empty() && get<0>(copy[199]) == 0.0f);
+    copy.Clear();
+    assert(copy.IsEmpty() && (copy == SoASimpleVector<float, float, string>()));
+
+    // Исключение в одном столбце откатывает строку целиком
+    {
+        SoASimpleVector<Counted, ThrowingCopy> rows;
+        rows.Reserve(4);
+        Counted::Reset();
+        const ThrowingCopy prototype;
+        ThrowingCopy::copies_left = 1;
+        try {
+            rows.EmplaceBack(Counted(), prototype);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+        assert(rows.IsEmpty() && Counted::constructed == Counted::destroyed);
+
+        // Сбой при перевыделении оставляет вектор прежним
+        ThrowingCopy::copies_left = 100;
+        for (int i = 0; i < 4; ++i) {
+            rows.EmplaceBack(Counted(), prototype);
+        }
+        ThrowingCopy::copies_left = 3;
+        try {
+            rows.EmplaceBack(Counted(), prototype);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+        assert(rows.GetSize() == 4 && rows.GetCapacity() == 4 && *get<1>(rows[3]).payload == 1);
+    }
+    assert(Counted::constructed == Counted::destroyed);
+
+    // Перемещаемый столбец перед копируемым: строки не должны остаться перемещёнными
+    {
+        SoASimpleVector<string, ThrowingCopy> rows;
+        rows.Reserve(2);
+        const ThrowingCopy prototype;
+        ThrowingCopy::copies_left = 100;
+        rows.EmplaceBack("first-string-longer-than-sso"s, prototype);
+        rows.EmplaceBack("second-string-longer-than-sso"s, prototype);
+        ThrowingCopy::copies_left = 2;
+        try {
+            rows.EmplaceBack("third"s, prototype);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+        assert(rows.GetSize() == 2 && rows.GetCapacity() == 2);
+        assert(get<0>(rows[0]) == "first-string-longer-than-sso"s && get<0>(rows[1]) == "second-string-longer-than-sso"s);
+        assert(*get<1>(rows[1]).payload == 1);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestBatchErase() {
+    cout << "Test swap erase and batch erase"s << endl;
+    SimpleVector<string> v{"a"s, "b"s, "c"s, "d"s};
+    auto it = v.SwapErase(v.begin() + 1);
+    assert(*it == "d"s && v == SimpleVector<string>({"a"s, "d"s, "c"s}));
+    it = v.SwapErase(v.end() - 1); // Последний элемент удаляется без переноса
+    assert(it == v.end() && v.GetSize() == 2);
+    try {
+        v.SwapErase(v.end());
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+
+    SimpleVector<int> numbers(1000);
+    iota(numbers.begin(), numbers.end(), 0);
+    assert(numbers.EraseIf([](int x) {
+        return x % 3 != 0;
+    }) == 666);
+    assert(numbers.GetSize() == 334 && numbers[1] == 3 && numbers[333] == 999);
+    assert(numbers.EraseIf([](int) {
+        return false;
+    }) == 0);
+
+    SimpleVector<int> repeated{1, 1, 2, 2, 2, 3, 1, 1};
+    assert(repeated.RemoveDuplicates() == 4 && repeated == SimpleVector<int>({1, 2, 3, 1}));
+    SimpleVector<int> parity{1, 3, 5, 2, 4, 7};
+    assert(parity.RemoveDuplicates([](int lhs, int rhs) {
+        return lhs % 2 == rhs % 2;
+    }) == 3 && parity == SimpleVector<int>({1, 2, 7}));
+
+    // Хвост разрушается ровно один раз
+    {
+        SimpleVector<Counted> counted(10);
+        Counted::Reset();
+        size_t index = 0;
+        assert(counted.EraseIf([&index](const Counted&) {
+            return index++ % 2 == 0;
+        }) == 5);
+        assert(Counted::destroyed == 5 && Counted::constructed == 0);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSegmentedSimpleVector() {
+    cout << "Test segmented simple vector"s << endl;
+    static_assert(DefaultSegmentSize<int>() == 16384);
+    static_assert(DefaultSegmentSize<char[100000]>() == 1);
+
+    SegmentedSimpleVector<int, 4> v;
+    v.PushBack(0);
+    int& first = v[0];
+    const int* first_address = &first;
+    for (int i = 1; i < 10; ++i) {
+        v.PushBack(i);
+    }
+    // Рост не переносит элементы
+    assert(&v[0] == first_address && first == 0);
+    assert(v.GetSize() == 10 && v.GetCapacity() == 12 && v.GetSegmentCount() == 3);
+    assert(v.At(9) == 9 && v.Back() == 9);
+    try {
+        v.At(10);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+
+    // Итераторы произвольного доступа работают со стандартными алгоритмами
+    assert(accumulate(v.begin(), v.end(), 0) == 45);
+    assert(v.end() - v.begin() == 10 && *(v.begin() + 5) == 5 && v.cbegin()[7] == 7);
+    assert(binary_search(v.begin(), v.end(), 6));
+
+    // Обход по сегментам
+    SimpleVector<size_t> lengths;
+    v.ForEachSegment([&lengths](SimpleVectorView<int> segment) {
+        lengths.PushBack(segment.GetSize());
+    });
+    assert(lengths == SimpleVector<size_t>({4, 4, 2}));
+    assert(v.Segment(1)[0] == 4);
+
+    SimpleVector<int> contiguous = v.ToContiguous();
+    assert(contiguous.GetSize() == 10 && contiguous.GetCapacity() == 10);
+    assert(equal(contiguous.begin(), contiguous.end(), v.begin()));
+
+    // Копирование и сравнение
+    SegmentedSimpleVector<int, 4> copy = v;
+    assert(copy == v);
+    copy[3] = 100;
+    assert(copy != v && v < copy);
+
+    // Уменьшение оставляет сегменты в запасе, ShrinkToFit их отдаёт
+    v.Resize(3);
+    assert(v.GetSize() == 3 && v.GetCapacity() == 12);
+    assert(v.ShrinkToFit() == 2 * 4 * sizeof(int) && v.GetCapacity() == 4);
+    v.Resize(6);
+    assert(v[2] == 2 && v[3] == 0 && v[5] == 0 && v.GetCapacity() == 8);
+
+    SegmentedSimpleVector<int, 4> initialized = {1, 2, 3, 4, 5};
+    SegmentedSimpleVector<int, 4> filled(5, 7);
+    assert(initialized.Back() == 5 && filled[4] == 7);
+    filled.swap(initialized);
+    assert(filled[0] == 1 && initialized[0] == 7);
+
+    // Каждый элемент разрушается ровно один раз, в том числе после переноса в SimpleVector
+    Counted::Reset();
+    {
+        SegmentedSimpleVector<Counted, 8> counted(20);
+        counted.PopBack();
+        counted.Resize(10);
+        SimpleVector<Counted> moved = move(counted).ToContiguous();
+        assert(moved.GetSize() == 10 && counted.IsEmpty() && counted.GetCapacity() == 0);
+    }
+    assert(Counted::constructed == Counted::destroyed);
+
+    SegmentedSimpleVector<string, 2> strings;
+    for (int i = 0; i < 7; ++i) {
+        strings.EmplaceBack(5, static_cast<char>('a' + i));
+    }
+    SegmentedSimpleVector<string, 2> moved_strings(move(strings));
+    assert(strings.IsEmpty() && moved_strings[6] == "ggggg"s);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestHugePageAllocator() {
+    cout << "Test huge page allocator"s << endl;
+    using Vector = SimpleVector<int, HugePageAllocator<int>, PageRoundedGrowth<kHugePageSize>, VectorStats>;
+    const HugePageAllocator<int> alloc(HugePageOptions{4096});
+
+    // Небольшие буферы — из кучи, крупные — отображения, выровненные на большую страницу
+    Vector v(alloc);
+    v.Reserve(100);
+    for (int i = 0; i < 2000; ++i) {
+        v.PushBack(i);
+    }
+    assert(IsAlignedPointer(v.begin(), kHugePageSize));
+
+    // В пределах отображённой большой страницы буфер растёт на месте
+    const int* mapped = v.begin();
+    const size_t relocated = v.GetStats().elements_relocated_bitwise;
+    for (int i = 2000; i < 100'000; ++i) {
+        v.PushBack(i);
+    }
+    assert(v.begin() == mapped);
+
+    // Дальнейший рост идёт через mremap: элементы не переносятся поэлементно
+    for (int i = 100'000; i < 3'000'000; ++i) {
+        v.PushBack(i);
+    }
+    v.Reserve(10'000'000);
+    assert(v.GetStats().elements_relocated_bitwise == relocated);
+    assert(v.GetSize() == 3'000'000 && v[0] == 0 && v[2'999'999] == 2'999'999);
+    assert(IsAlignedPointer(v.begin(), kHugePageSize));
+
+    // Уменьшение до кучи и обратно
+    v.Resize(10);
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 10 && v[9] == 9);
+    Vector copy = v;
+    assert(copy == v);
+
+    // Привязка к узлу NUMA: несуществующий узел отвергается
+    try {
+        HugePageSimpleVector<double> bad(::Reserve(1 << 20), HugePageAllocator<double>(HugePageOptions{kHugePageSize, 1 << 20}));
+        assert(false);
+    }
+    catch (const system_error&) {
+    }
+    try {
+        HugePageSimpleVector<double> bound(1 << 20, HugePageAllocator<double>(HugePageOptions{kHugePageSize, 0, true}));
+        assert(bound[(1 << 20) - 1] == 0.0);
+    }
+    catch (const system_error&) {
+        // Ядро без NUMA отвечает на mbind ошибкой
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable growth"s << endl;
+    static_assert(kRelocateBitwise<int> && kRelocateBitwise<Handle> && !kRelocateBitwise<string>);
+    static_assert(!kShiftBitwise<Handle>);
+    {
+        // Помеченный тип переносится memcpy и без деструкторов исходных объектов
+        SimpleVector<Handle, allocator<Handle>, DoublingGrowth, VectorStats> handles;
+        for (int i = 0; i < 1000; ++i) {
+            handles.EmplaceBack(i);
+        }
+        assert(Handle::live == 1000);
+        assert(handles.GetStats().elements_relocated_bitwise > 0 && handles.GetStats().elements_moved == 0);
+        handles.Insert(handles.begin() + 1, Handle(-1));
+        handles.Erase(handles.begin());
+        handles.ShrinkToFit();
+        assert(handles[0].Get() == -1 && handles[999].Get() == 999 && Handle::live == 1000);
+
+        // Через realloc
+        ReallocSimpleVector<Handle> reallocated;
+        for (int i = 0; i < 1000; ++i) {
+            reallocated.PushBack(Handle(i));
+        }
+        reallocated.Insert(reallocated.begin(), Handle(-1));
+        reallocated.Erase(reallocated.begin() + 500);
+        reallocated.ShrinkToFit();
+        assert(reallocated.GetSize() == 1000 && reallocated[0].Get() == -1 && reallocated[999].Get() == 999);
+        assert(Handle::live == 2000);
+
+        // Столбцы SoA тоже переносятся побайтово
+        SoASimpleVector<int, Handle> rows;
+        for (int i = 0; i < 100; ++i) {
+            rows.EmplaceBack(i, Handle(i));
+        }
+        assert(get<1>(rows[99]).Get() == 99 && Handle::live == 2100);
+    }
+    assert(Handle::live == 0);
+
+    ReallocSimpleVector<int> numbers;
+    for (int i = 0; i < 1'000'000; ++i) {
+        numbers.PushBack(i);
+    }
+    numbers.Reserve(4'000'000);
+    numbers.Resize(10);
+    numbers.ShrinkToFit();
+    assert(numbers.GetCapacity() == 10 && numbers[9] == 9);
+    assert(numbers == ReallocSimpleVector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    cout << "Done!"s << endl << endl;
+}
+
+// Значение, копия которого бросает, когда счётчик доходит до нуля; перемещения нет
+struct FlakyCopy {
+    static inline int copies_left = -1; // Отрицательный — не бросать
+
+    FlakyCopy(int value)
+        : value(value) {}
+    FlakyCopy(const FlakyCopy& other)
+        : value(other.value) {
+        if (copies_left >= 0 && copies_left-- == 0) {
+            throw runtime_error("copy failed");
+        }
+    }
+    FlakyCopy& operator=(const FlakyCopy&) = default;
+
+    bool operator==(const FlakyCopy& other) const {
+        return value == other.value;
+    }
+
+    int value;
+};
+
+// Сравнение, которое бросает после заданного числа вызовов
+struct FlakyLess {
+    static inline int calls_left = -1;
+
+    bool operator()(int lhs, int rhs) const {
+        if (calls_left >= 0 && calls_left-- == 0) {
+            throw runtime_error("compare failed");
+        }
+        return lhs < rhs;
+    }
+};
+
+void TestFlatContainers() {
+    cout << "Test flat set and flat map"s << endl;
+    // Поиск без ветвлений совпадает с lower_bound на всех позициях, включая концы
+    for (int size = 0; size < 40; ++size) {
+        SimpleVector<int> sorted(size);
+        for (int i = 0; i < size; ++i) {
+            sorted[i] = i * 2;
+        }
+        for (int key = -1; key <= size * 2; ++key) {
+            const size_t expected = lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+            assert(BranchlessLowerBound(sorted.begin(), sorted.GetSize(), key, less<int>()) == expected);
+        }
+    }
+
+    SimpleFlatSet<int> set = {5, 1, 3, 3, 9};
+    assert(set.GetSize() == 4 && set.Keys() == SimpleVector<int>({1, 3, 5, 9}));
+    assert(set.Contains(3) && !set.Contains(4) && set.Find(4) == set.end() && *set.LowerBound(4) == 5);
+    assert(set.Insert(4).second && !set.Insert(4).second);
+    SimpleVector<int> batch{10, 0, 5, 7, 7, 2};
+    set.InsertSorted(batch.begin(), batch.end());
+    assert(set.Keys() == SimpleVector<int>({0, 1, 2, 3, 4, 5, 7, 9, 10}));
+    assert(set.Erase(3) == 1 && set.Erase(3) == 0 && set.GetSize() == 8);
+    assert(is_sorted(set.begin(), set.end()));
+
+    SimpleFlatSet<string, greater<string>> reversed = {"b"s, "c"s, "a"s};
+    assert(*reversed.begin() == "c"s && reversed.Count("a"s) == 1);
+
+    SimpleFlatMap<string, int> map = {{"one"s, 1}, {"three"s, 3}, {"two"s, 2}, {"one"s, 100}};
+    assert(map.GetSize() == 3 && map.At("one"s) == 1); // Из повторов остаётся первая пара
+    assert(map.Keys() == SimpleVector<string>({"one"s, "three"s, "two"s}));
+    assert(as_const(map).Values() == SimpleVector<int>({1, 3, 2}));
+    assert(map.Find("four"s) == nullptr && *map.Find("two"s) == 2);
+    try {
+        map.At("four"s);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+    map["four"s] = 4;
+    ++map["one"s];
+    assert(map.At("four"s) == 4 && map.At("one"s) == 2 && map.GetSize() == 4);
+    assert(!map.Insert("two"s, 20).second && map.At("two"s) == 2);
+    assert(*map.TryEmplace("zero"s, 0).first == 0);
+
+    // Пачка сливается с прежними парами; прежние значения не перезаписываются
+    SimpleVector<pair<string, int>> pairs{{"six"s, 6}, {"five"s, 5}, {"two"s, 22}, {"six"s, 66}};
+    map.InsertSorted(pairs.begin(), pairs.end());
+    assert(map.Keys() == SimpleVector<string>({"five"s, "four"s, "one"s, "six"s, "three"s, "two"s, "zero"s}));
+    assert(as_const(map).Values() == SimpleVector<int>({5, 4, 2, 6, 3, 2, 0}));
+    assert(map.Erase("four"s) == 1 && !map.Contains("four"s) && map.KeyAt(1) == "one"s && map.ValueAt(1) == 2);
+
+    int sum = 0;
+    map.ForEach([&sum](const string&, int& value) {
+        sum += value;
+    });
+    assert(sum == 18);
+
+    SimpleFlatMap<string, int> copy = map;
+    assert(copy == map);
+    copy["one"s] = 0;
+    assert(copy != map);
+
+    // Сбой посреди InsertSorted оставляет карту и множество прежними
+    {
+        SimpleFlatMap<string, FlakyCopy> flaky;
+        for (int i = 0; i < 5; ++i) {
+            flaky.Insert("key-longer-than-sso-"s + to_string(i * 2), FlakyCopy(i * 2));
+        }
+        const SimpleFlatMap<string, FlakyCopy> before = flaky;
+        SimpleVector<pair<string, FlakyCopy>> odd;
+        for (int i = 0; i < 5; ++i) {
+            odd.PushBack({"key-longer-than-sso-"s + to_string(i * 2 + 1), FlakyCopy(i * 2 + 1)});
+        }
+        int failures = 0;
+        for (int budget = 0;; ++budget) {
+            FlakyCopy::copies_left = budget;
+            try {
+                flaky.InsertSorted(odd.begin(), odd.end());
+                FlakyCopy::copies_left = -1;
+                break;
+            }
+            catch (const runtime_error&) {
+                FlakyCopy::copies_left = -1;
+                ++failures;
+                assert(flaky == before);
+            }
+        }
+        assert(failures > 0 && flaky.GetSize() == 10 && is_sorted(flaky.Keys().begin(), flaky.Keys().end()));
+        flaky.ForEach([](const string& key, FlakyCopy& value) {
+            assert(key == "key-longer-than-sso-"s + to_string(value.value));
+        });
+    }
+    {
+        SimpleFlatSet<int, FlakyLess> flaky = {8, 2, 6, 4};
+        const SimpleFlatSet<int, FlakyLess> before = flaky;
+        const SimpleVector<int> values{7, 1, 5, 3, 9, 2};
+        int failures = 0;
+        for (int budget = 0;; ++budget) {
+            FlakyLess::calls_left = budget;
+            try {
+                flaky.InsertSorted(values.begin(), values.end());
+                FlakyLess::calls_left = -1;
+                break;
+            }
+            catch (const runtime_error&) {
+                FlakyLess::calls_left = -1;
+                ++failures;
+                assert(flaky == before);
+            }
+        }
+        assert(failures > 0 && flaky.Keys() == SimpleVector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSimpleRingVector() {
+    cout << "Test simple ring vector"s << endl;
+    assert(RoundUpToPowerOfTwo(0) == 1 && RoundUpToPowerOfTwo(5) == 8 && RoundUpToPowerOfTwo(64) == 64);
+
+    SimpleRingVector<int> ring(::Reserve(5));
+    assert(ring.GetCapacity() == 8 && ring.IsEmpty());
+    for (int i = 0; i < 4; ++i) {
+        ring.PushBack(i);
+        ring.PushFront(-i - 1);
+    }
+    // Полный буфер, элементы переходят через его конец
+    assert(ring.GetSize() == 8 && ring.GetCapacity() == 8 && !ring.IsContiguous());
+    assert(ring.Front() == -4 && ring.Back() == 3 && ring[4] == 0 && ring.At(7) == 3);
+    const auto [first_run, second_run] = ring.GetRuns();
+    assert(first_run.GetSize() + second_run.GetSize() == 8);
+    SimpleVectorView<int> line = ring.Linearize();
+    assert(ring.IsContiguous() && line.GetSize() == 8 && is_sorted(line.begin(), line.end()));
+    assert(ring.GetCapacity() == 8 && line[0] == -4);
+    try {
+        ring.At(8);
+        assert(false);
+    }
+    catch (const out_of_range&) {
+    }
+
+    // Рост при полном буфере с обоих концов; аргумент может ссылаться на элемент
+    ring.PushFront(ring.Back());
+    ring.PushBack(ring.Front());
+    assert(ring.GetSize() == 10 && ring.GetCapacity() == 16 && ring.Front() == 3 && ring.Back() == 3);
+
+    // Сверка с std::deque на случайной последовательности операций
+    SimpleRingVector<string> strings;
+    deque<string> expected;
+    uint32_t seed = 7;
+    for (int step = 0; step < 5000; ++step) {
+        seed = seed * 1664525u + 1013904223u;
+        const string value = to_string(step) + "-value-longer-than-sso"s;
+        switch (seed >> 30) {
+            case 0:
+                strings.PushBack(value);
+                expected.push_back(value);
+                break;
+            case 1:
+                strings.EmplaceFront(value);
+                expected.push_front(value);
+                break;
+            case 2:
+                if (!expected.empty()) {
+                    strings.PopBack();
+                    expected.pop_back();
+                }
+                break;
+            default:
+                if (!expected.empty()) {
+                    strings.PopFront();
+                    expected.pop_front();
+                }
+                break;
+        }
+        assert(strings.GetSize() == expected.size());
+    }
+    assert(equal(strings.begin(), strings.end(), expected.begin(), expected.end()));
+    SimpleRingVector<string> copy = strings;
+    assert(copy == strings && equal(copy.cbegin(), copy.cend(), expected.begin()));
+    SimpleRingVector<string> moved = move(copy);
+    assert(copy.IsEmpty() && moved == strings);
+    SimpleVectorView<string> strings_line = moved.Linearize();
+    assert(equal(strings_line.begin(), strings_line.end(), expected.begin(), expected.end()));
+
+    Counted::Reset();
+    {
+        SimpleRingVector<Counted> counted;
+        for (int i = 0; i < 20; ++i) {
+            counted.EmplaceFront();
+            counted.EmplaceBack();
+            counted.PopFront();
+        }
+        counted.Linearize();
+    }
+    assert(Counted::constructed == Counted::destroyed);
+
+    // Очередь одного производителя и одного потребителя
+    SpscRingVector<string> queue(3);
+    assert(queue.GetCapacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.TryPush(to_string(i)));
+    }
+    assert(!queue.TryPush("overflow"s) && queue.GetSize() == 4);
+    string popped;
+    assert(queue.TryPop(popped) && popped == "0"s && *queue.TryFront() == "1"s);
+
+    constexpr int kItems = 200'000;
+    SpscRingVector<int> numbers(256);
+    thread producer([&numbers] {
+        for (int i = 0; i < kItems; ++i) {
+            while (!numbers.TryPush(i)) {
+                this_thread::yield();
+            }
+        }
+    });
+    int next = 0;
+    while (next < kItems) {
+        int value = 0;
+        if (numbers.TryPop(value)) {
+            assert(value == next);
+            ++next;
+        }
+    }
+    producer.join();
+    assert(numbers.GetSize() == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestDestroyOnRemove() {
+    cout << "Test removal destroys elements"s << endl;
+    // Удаление вызывает деструкторы, а не присваивает Type()
+    Counted::Reset();
+    {
+        SimpleVector<Counted> v(10);
+        assert(Counted::constructed == 10);
+        v.PopBack();
+        assert(Counted::destroyed == 1 && Counted::constructed == 10);
+        v.Resize(5);
+        assert(Counted::destroyed == 5 && Counted::constructed == 10);
+        v.Resize(8); // Конструируются только три новых элемента
+        assert(Counted::constructed == 13 && Counted::destroyed == 5);
+        v.Clear();
+        assert(Counted::destroyed == 13 && v.GetCapacity() >= 8);
+    }
+    assert(Counted::constructed == Counted::destroyed);
+
+    // Ресурсы удалённых элементов освобождаются сразу
+    auto resource = make_shared<int>(42);
+    SimpleVector<shared_ptr<int>> owners(3, resource);
+    assert(resource.use_count() == 4);
+    owners.PopBack();
+    assert(resource.use_count() == 3);
+    owners.Erase(owners.begin());
+    assert(resource.use_count() == 2);
+    owners.Clear();
+    assert(resource.use_count() == 1);
+
+    // ResizeUninitialized сохраняет прежние элементы и не трогает новые
+    SimpleVector<int> frame = {1, 2, 3};
+    frame.ResizeUninitialized(1000);
+    assert(frame.GetSize() == 1000 && frame[0] == 1 && frame[2] == 3);
+    fill(frame.begin() + 3, frame.end(), 7);
+    assert(frame[999] == 7);
+    const int* data = frame.begin();
+    frame.ResizeUninitialized(0);
+    assert(frame.IsEmpty() && frame.GetCapacity() >= 1000);
+    frame.ResizeUninitialized(500); // В пределах ёмкости — без перевыделения
+    assert(frame.GetSize() == 500 && frame.begin() == data);
+    cout << "Done!"s << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -159,5 +1808,34 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestReserveDoesNotConstruct();
+    TestNoDefaultConstructible();
+    TestEmplace();
+    TestRelocation();
+    TestAllocator();
+    TestSmallSimpleVector();
+    TestGrowthPolicy();
+    TestShrink();
+    TestRangeOperations();
+    TestStats();
+    TestComparisonKernels();
+    TestParallelAlgorithms();
+    TestConcurrentSimpleVector();
+    TestSimpleVectorCollector();
+    TestMappedSimpleVector();
+    TestSerialization();
+    TestSimpleVectorView();
+    TestCowSimpleVector();
+    TestStaticSimpleVector();
+    TestSimpleVectorArena();
+    TestAlignedStorage();
+    TestSoASimpleVector();
+    TestBatchErase();
+    TestSegmentedSimpleVector();
+    TestHugePageAllocator();
+    TestTriviallyRelocatable();
+    TestFlatContainers();
+    TestSimpleRingVector();
+    TestDestroyOnRemove();
     return 0;
 }
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "growth_policy.h"
+
+// Заголовок файла MappedSimpleVector. Лежит в начале отображения, поэтому размер
+// обновляется прямо в файле; занимает целую кэш-линию, чтобы элементы были выровнены
+struct alignas(64) MappedVectorHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t size;
+    std::uint64_t capacity;
+};
+
+inline constexpr std::uint64_t kMappedVectorMagic = 0x3130564D50414D53; // "SMAPMV01"
+inline constexpr std::uint32_t kMappedVectorVersion = 1;
+
+// Вектор тривиально копируемых элементов, чей буфер — отображённый в память файл (POSIX).
+// Открытие существующего файла не копирует данные: элементы читаются прямо из страниц файла.
+// Reserve растит файл через ftruncate и mremap, Sync сбрасывает изменения на диск.
+// При открытии заголовок проверяется, и файл с другим размером элемента или версией отвергается.
+// Вектор после перемещения пуст и не связан с файлом: чтение и Clear работают,
+// а рост бросает std::logic_error, пока ему не присвоят открытый вектор
+template <typename Type, typename GrowthPolicy = PageRoundedGrowth<>>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "MappedSimpleVector stores elements as raw bytes");
+    static_assert(alignof(Type) <= alignof(MappedVectorHeader), "Element alignment exceeds header alignment");
+
+    static constexpr size_t kHeaderBytes = sizeof(MappedVectorHeader);
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Открывает файл path или создаёт пустой, если его нет.
+    // Бросает std::system_error при ошибке ввода-вывода и std::runtime_error при неверном заголовке
+    explicit MappedSimpleVector(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            ThrowErrno("open");
+        }
+        try {
+            struct stat info;
+            if (::fstat(fd_, &info) != 0) {
+                ThrowErrno("fstat");
+            }
+            if (info.st_size == 0) {
+                Truncate(kHeaderBytes);
+                Map(kHeaderBytes);
+                *Header() = {kMappedVectorMagic, kMappedVectorVersion, sizeof(Type), 0, 0};
+            }
+            else {
+                const size_t file_bytes = static_cast<size_t>(info.st_size);
+                if (file_bytes < kHeaderBytes) {
+                    throw std::runtime_error("Mapped vector file is too short");
+                }
+                Map(file_bytes);
+                Validate(file_bytes);
+            }
+        }
+        catch (...) {
+            Close();
+            throw;
+        }
+    }
+
+    ~MappedSimpleVector() {
+        Close();
+    }
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1)),
+          map_(std::exchange(other.map_, nullptr)),
+          map_bytes_(std::exchange(other.map_bytes_, 0)) {}
+
+    MappedSimpleVector& operator=(MappedSimpleVector&& other) noexcept {
+        if (this != &other) {
+            Close();
+            fd_ = std::exchange(other.fd_, -1);
+            map_ = std::exchange(other.map_, nullptr);
+            map_bytes_ = std::exchange(other.map_bytes_, 0);
+        }
+        return *this;
+    }
+
+    // Оператор индексирования
+    Type& operator[](size_t index) noexcept {
+        assert(index < GetSize() && "Index out of range");
+        return Data()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < GetSize() && "Index out of range");
+        return Data()[index];
+    }
+
+    // Метод At с проверкой границ
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return Data()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return Data()[index];
+    }
+
+    // Итераторы. Становятся недействительными при росте ёмкости
+    Iterator begin() noexcept {
+        return Data();
+    }
+
+    Iterator end() noexcept {
+        return Data() + GetSize();
+    }
+
+    ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return Data() + GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    size_t GetSize() const noexcept {
+        return map_ == nullptr ? 0 : static_cast<size_t>(Header()->size);
+    }
+
+    size_t GetCapacity() const noexcept {
+        return map_ == nullptr ? 0 : static_cast<size_t>(Header()->capacity);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Обнуляет размер; файл сохраняет длину
+    void Clear() noexcept {
+        if (map_ != nullptr) {
+            Header()->size = 0;
+        }
+    }
+
+    // Добавление элемента в конец
+    void PushBack(const Type& item) {
+        const size_t size = GetSize();
+        if (size == GetCapacity()) {
+            Type copy = item; // item может лежать в отображении, которое mremap переместит
+            Reserve(GrowthPolicy::NextCapacity(size, size + 1, sizeof(Type)));
+            Data()[size] = copy;
+        }
+        else {
+            Data()[size] = item;
+        }
+        Header()->size = size + 1;
+    }
+
+    // Удаление последнего элемента
+    void PopBack() noexcept {
+        assert(GetSize() > 0 && "PopBack called on an empty container");
+        --Header()->size;
+    }
+
+    // Изменение размера; новые элементы инициализируются значением по умолчанию
+    void Resize(size_t new_size) {
+        const size_t size = GetSize();
+        if (new_size > GetCapacity()) {
+            Reserve(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)));
+        }
+        if (map_ == nullptr) {
+            return; // Вектор без файла, new_size == 0
+        }
+        if (new_size > size) {
+            std::uninitialized_value_construct(Data() + size, Data() + new_size);
+        }
+        Header()->size = new_size;
+    }
+
+    // Удлиняет файл и отображение до new_capacity элементов. Старые данные не копируются
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= GetCapacity()) {
+            return;
+        }
+        if (map_ == nullptr) {
+            throw std::logic_error("Mapped vector has no file (moved from)");
+        }
+        if (new_capacity > (SIZE_MAX - kHeaderBytes) / sizeof(Type)) {
+            throw std::length_error("Mapped vector capacity is too large");
+        }
+        const size_t bytes = kHeaderBytes + new_capacity * sizeof(Type);
+        Truncate(bytes);
+        Remap(bytes);
+        Header()->capacity = new_capacity;
+    }
+
+    // Синхронно записывает изменённые страницы на диск
+    void Sync() {
+        if (map_ != nullptr && ::msync(map_, map_bytes_, MS_SYNC) != 0) {
+            ThrowErrno("msync");
+        }
+    }
+
+private:
+    int fd_ = -1;
+    void* map_ = nullptr;
+    size_t map_bytes_ = 0;
+
+    MappedVectorHeader* Header() noexcept {
+        return static_cast<MappedVectorHeader*>(map_);
+    }
+
+    const MappedVectorHeader* Header() const noexcept {
+        return static_cast<const MappedVectorHeader*>(map_);
+    }
+
+    Type* Data() noexcept {
+        return map_ == nullptr ? nullptr : reinterpret_cast<Type*>(static_cast<unsigned char*>(map_) + kHeaderBytes);
+    }
+
+    const Type* Data() const noexcept {
+        return map_ == nullptr ? nullptr
+                               : reinterpret_cast<const Type*>(static_cast<const unsigned char*>(map_) + kHeaderBytes);
+    }
+
+    [[noreturn]] static void ThrowErrno(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void Validate(size_t file_bytes) const {
+        const MappedVectorHeader& header = *Header();
+        if (header.magic != kMappedVectorMagic) {
+            throw std::runtime_error("Not a mapped vector file");
+        }
+        if (header.version != kMappedVectorVersion) {
+            throw std::runtime_error("Unsupported mapped vector version");
+        }
+        if (header.element_size != sizeof(Type)) {
+            throw std::runtime_error("Mapped vector element size mismatch");
+        }
+        if (header.size > header.capacity ||
+            header.capacity > (file_bytes - kHeaderBytes) / sizeof(Type)) {
+            throw std::runtime_error("Mapped vector header is inconsistent with file size");
+        }
+    }
+
+    void Truncate(size_t bytes) {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            ThrowErrno("ftruncate");
+        }
+    }
+
+    void Map(size_t bytes) {
+        void* map = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            ThrowErrno("mmap");
+        }
+        map_ = map;
+        map_bytes_ = bytes;
+    }
+
+    // Растит отображение до bytes; на Linux без копирования и, если возможно, без переноса
+    void Remap(size_t bytes) {
+#ifdef MREMAP_MAYMOVE
+        void* map = ::mremap(map_, map_bytes_, bytes, MREMAP_MAYMOVE);
+        if (map == MAP_FAILED) {
+            ThrowErrno("mremap");
+        }
+        map_ = map;
+        map_bytes_ = bytes;
+#else
+        void* old_map = map_;
+        const size_t old_bytes = map_bytes_;
+        Map(bytes);
+        ::munmap(old_map, old_bytes);
+#endif
+    }
+
+    void Close() noexcept {
+        if (map_ != nullptr) {
+            ::munmap(map_, map_bytes_);
+            map_ = nullptr;
+            map_bytes_ = 0;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+};
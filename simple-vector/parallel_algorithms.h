@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+#include "parallel_pool.h"
+#include "simple_vector.h"
+
+// Параллельные заполнение, преобразование, свёртка и обход SimpleVector.
+// Диапазон режется на чанки, внутренние границы которых совпадают с границами кэш-линий,
+// чтобы соседние потоки не писали в одну линию. Новые элементы создаются прямо
+// в только что выделенной памяти тем потоком, который обрабатывает чанк, поэтому
+// при политике first-touch страницы оказываются на NUMA-узле этого потока.
+
+inline constexpr size_t kCacheLineSize = 64;
+
+struct ParallelOptions {
+    size_t serial_threshold = size_t{1} << 15; // Диапазоны короче обрабатываются в вызывающем потоке
+    size_t min_chunk_bytes = size_t{16} << 10;
+    ParallelPool* pool = nullptr; // nullptr — DefaultParallelPool()
+};
+
+// Разбиение [0, size) на чанки; чанк c занимает [Begin(c), End(c))
+struct ChunkPlan {
+    size_t size = 0;
+    size_t chunk = 1;
+    size_t shift = 0; // Сдвиг сетки чанков, выравнивающий границы по кэш-линиям
+    size_t count = 0;
+
+    size_t Begin(size_t c) const noexcept {
+        return c * chunk < shift ? 0 : c * chunk - shift;
+    }
+
+    size_t End(size_t c) const noexcept {
+        return std::min(size, (c + 1) * chunk - shift);
+    }
+};
+
+template <typename Type>
+ChunkPlan MakeChunkPlan(const Type* data, size_t size, size_t threads, const ParallelOptions& options) {
+    // Элементов в кэш-линии; если тип не делит линию нацело, выравнивание невозможно
+    const size_t line = kCacheLineSize % sizeof(Type) == 0 ? kCacheLineSize / sizeof(Type) : 1;
+
+    ChunkPlan plan;
+    plan.size = size;
+    const size_t per_thread = (size + threads * 4 - 1) / (threads * 4); // Несколько чанков на поток для баланса
+    plan.chunk = std::max({per_thread, options.min_chunk_bytes / sizeof(Type), size_t{1}});
+    plan.chunk = (plan.chunk + line - 1) / line * line;
+
+    const auto address = reinterpret_cast<std::uintptr_t>(data);
+    if (line > 1 && address % sizeof(Type) == 0) {
+        const size_t head = (kCacheLineSize - address % kCacheLineSize) % kCacheLineSize / sizeof(Type);
+        plan.shift = (plan.chunk - head % plan.chunk) % plan.chunk;
+    }
+    plan.count = (size + plan.shift + plan.chunk - 1) / plan.chunk;
+    return plan;
+}
+
+// Вызывает body(begin_index, end_index) для чанков [0, size)
+template <typename Type, typename Body>
+void ParallelForChunks(const Type* data, size_t size, const ParallelOptions& options, Body&& body) {
+    if (size == 0) {
+        return;
+    }
+    ParallelPool& pool = options.pool != nullptr ? *options.pool : DefaultParallelPool();
+    if (size < options.serial_threshold || pool.GetThreadCount() == 1) {
+        body(size_t{0}, size);
+        return;
+    }
+
+    const ChunkPlan plan = MakeChunkPlan(data, size, pool.GetThreadCount(), options);
+    auto run_chunk = [&](size_t chunk) {
+        body(plan.Begin(chunk), plan.End(chunk));
+    };
+    pool.Run(plan.count, run_chunk);
+}
+
+// Создаёт size элементов в неинициализированной памяти raw; construct(begin, end) создаёт
+// элементы [begin, end) или, разрушив свои, бросает исключение. При ошибке в любом чанке
+// разрушаются элементы всех успешных чанков, и исключение уходит вызывающему
+template <typename Type, typename Construct>
+void ParallelConstruct(Type* raw, size_t size, const ParallelOptions& options, Construct&& construct) {
+    ParallelPool& pool = options.pool != nullptr ? *options.pool : DefaultParallelPool();
+    if (size < options.serial_threshold || pool.GetThreadCount() == 1) {
+        construct(size_t{0}, size);
+        return;
+    }
+
+    const ChunkPlan plan = MakeChunkPlan(raw, size, pool.GetThreadCount(), options);
+    std::unique_ptr<bool[]> constructed(new bool[plan.count]()); // Каждый поток пишет только свой флаг
+    auto run_chunk = [&](size_t chunk) {
+        construct(plan.Begin(chunk), plan.End(chunk));
+        constructed[chunk] = true;
+    };
+    try {
+        pool.Run(plan.count, run_chunk);
+    }
+    catch (...) {
+        for (size_t chunk = 0; chunk < plan.count; ++chunk) {
+            if (constructed[chunk]) {
+                std::destroy(raw + plan.Begin(chunk), raw + plan.End(chunk));
+            }
+        }
+        throw;
+    }
+}
+
+// Заменяет содержимое v на size копий value, создавая их параллельно
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void ParallelFill(SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v, size_t size, const Type& value,
+                  const ParallelOptions& options = {}) {
+    v.Clear();
+    v.Reserve(size);
+    v.ConstructBack(size, [&](Type* raw, size_t count) {
+        ParallelConstruct(raw, count, options, [&](size_t first, size_t last) {
+            std::uninitialized_fill(raw + first, raw + last, value);
+        });
+    });
+}
+
+// Заменяет содержимое dst на op(x) для каждого x из src. src и dst — разные векторы
+template <typename In, typename InAlloc, typename InGrowth, typename InStats,
+          typename Out, typename OutAlloc, typename OutGrowth, typename OutStats, typename UnaryOp>
+void ParallelTransform(const SimpleVector<In, InAlloc, InGrowth, InStats>& src,
+                       SimpleVector<Out, OutAlloc, OutGrowth, OutStats>& dst, UnaryOp op,
+                       const ParallelOptions& options = {}) {
+    assert(static_cast<const void*>(&src) != static_cast<const void*>(&dst));
+    const In* input = src.begin();
+    dst.Clear();
+    dst.Reserve(src.GetSize());
+    dst.ConstructBack(src.GetSize(), [&](Out* raw, size_t count) {
+        ParallelConstruct(raw, count, options, [&](size_t first, size_t last) {
+            size_t i = first;
+            try {
+                for (; i < last; ++i) {
+                    ::new (static_cast<void*>(raw + i)) Out(op(input[i]));
+                }
+            }
+            catch (...) {
+                std::destroy(raw + first, raw + i);
+                throw;
+            }
+        });
+    });
+}
+
+// Заменяет каждый элемент v на op(элемент)
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats, typename UnaryOp>
+void ParallelTransformInPlace(SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v, UnaryOp op,
+                              const ParallelOptions& options = {}) {
+    Type* data = v.begin();
+    ParallelForChunks(data, v.GetSize(), options, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            data[i] = op(std::move(data[i]));
+        }
+    });
+}
+
+// Вызывает f(элемент) для каждого элемента v
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats, typename Function>
+void ParallelForEach(SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v, Function f,
+                     const ParallelOptions& options = {}) {
+    Type* data = v.begin();
+    ParallelForChunks(data, v.GetSize(), options, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            f(data[i]);
+        }
+    });
+}
+
+// Свёртка op(...op(op(init, v[0]), v[1])...). op должна быть ассоциативной и принимать
+// как (T, Type), так и (T, T): чанки сворачиваются независимо, частичные результаты объединяются по порядку
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats, typename T, typename BinaryOp>
+T ParallelReduce(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v, T init, BinaryOp op,
+                 const ParallelOptions& options = {}) {
+    const Type* data = v.begin();
+    ParallelPool& pool = options.pool != nullptr ? *options.pool : DefaultParallelPool();
+    if (v.GetSize() < options.serial_threshold || pool.GetThreadCount() == 1) {
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            init = op(std::move(init), data[i]);
+        }
+        return init;
+    }
+
+    const ChunkPlan plan = MakeChunkPlan(data, v.GetSize(), pool.GetThreadCount(), options);
+    SimpleVector<std::optional<T>> partials(plan.count);
+    auto run_chunk = [&](size_t chunk) {
+        const size_t first = plan.Begin(chunk);
+        T acc = static_cast<T>(data[first]);
+        for (size_t i = first + 1; i < plan.End(chunk); ++i) {
+            acc = op(std::move(acc), data[i]);
+        }
+        partials[chunk].emplace(std::move(acc));
+    };
+    pool.Run(plan.count, run_chunk);
+
+    for (std::optional<T>& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
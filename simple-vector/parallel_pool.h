@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков для параллельных алгоритмов над SimpleVector.
+// Задача делится на чанки, и каждый свободный поток забирает следующий чанк
+// из общего атомарного счётчика, так что быстрые потоки разбирают работу медленных.
+// Вызывающий поток тоже участвует в работе.
+class ParallelPool {
+public:
+    // thread_count — общее число исполнителей вместе с вызывающим потоком
+    explicit ParallelPool(size_t thread_count = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+        for (size_t i = 1; i < thread_count; ++i) {
+            workers_.emplace_back([this] {
+                WorkerLoop();
+            });
+        }
+    }
+
+    ~ParallelPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ParallelPool(const ParallelPool&) = delete;
+    ParallelPool& operator=(const ParallelPool&) = delete;
+
+    size_t GetThreadCount() const noexcept {
+        return workers_.size() + 1;
+    }
+
+    // Вызывает body(chunk) для каждого chunk из [0, chunk_count) и ждёт завершения.
+    // Первое брошенное исключение передаётся вызывающему после окончания всех чанков.
+    // Вложенный вызов из задачи пула выполняется последовательно
+    template <typename Body>
+    void Run(size_t chunk_count, Body& body) {
+        if (workers_.empty() || chunk_count <= 1 || inside_pool_) {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+                body(chunk);
+            }
+            return;
+        }
+
+        std::lock_guard run_lock(run_mutex_); // Одновременно выполняется одна задача
+        {
+            std::lock_guard lock(mutex_);
+            body_ = &body;
+            invoke_ = [](void* erased_body, size_t chunk) {
+                (*static_cast<Body*>(erased_body))(chunk);
+            };
+            chunk_count_ = chunk_count;
+            next_chunk_.store(0, std::memory_order_relaxed);
+            error_ = nullptr;
+            active_workers_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        inside_pool_ = true;
+        Work();
+        inside_pool_ = false;
+
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] {
+            return active_workers_ == 0;
+        });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool stop_ = false;
+    size_t generation_ = 0;
+    size_t active_workers_ = 0;
+
+    // Текущая задача; публикуется под mutex_ вместе с generation_
+    void* body_ = nullptr;
+    void (*invoke_)(void*, size_t) = nullptr;
+    size_t chunk_count_ = 0;
+    std::atomic<size_t> next_chunk_ = 0;
+    std::exception_ptr error_;
+
+    static inline thread_local bool inside_pool_ = false;
+
+    void Work() noexcept {
+        for (size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed); chunk < chunk_count_;
+             chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                invoke_(body_, chunk);
+            }
+            catch (...) {
+                std::lock_guard lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void WorkerLoop() {
+        inside_pool_ = true;
+        size_t seen_generation = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&] {
+                    return stop_ || generation_ != seen_generation;
+                });
+                if (stop_) {
+                    return;
+                }
+                seen_generation = generation_;
+            }
+
+            Work();
+
+            std::lock_guard lock(mutex_);
+            if (--active_workers_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+};
+
+// Общий пул по умолчанию на все ядра
+inline ParallelPool& DefaultParallelPool() {
+    static ParallelPool pool;
+    return pool;
+}
@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Проверка производительности горячих путей SimpleVector по записанному эталону.
+
+record: прогоняет бенчмарки и сохраняет медианы пропускной способности в файл эталона.
+check:  прогоняет те же бенчмарки и завершается с ошибкой, если пропускная способность
+        какого-либо из них упала больше чем на --tolerance процентов.
+
+Эталон зависит от машины, поэтому записывается там же, где потом проверяется.
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+
+# PushBack, Insert и Reserve (BM_PushBackReserved) самого SimpleVector
+DEFAULT_FILTER = r"^BM_(PushBack|PushBackReserved|Insert)<SimpleVector<"
+
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def run_benchmarks(bench, bench_filter, repetitions):
+    output = subprocess.run(
+        [
+            bench,
+            "--benchmark_filter=" + bench_filter,
+            "--benchmark_repetitions=%d" % repetitions,
+            "--benchmark_report_aggregates_only=true",
+            "--benchmark_format=json",
+        ],
+        check=True,
+        stdout=subprocess.PIPE,
+        text=True,
+    ).stdout
+    entries = json.loads(output)["benchmarks"]
+    # С одним повторением Google Benchmark не выводит агрегаты: берём сами прогоны
+    has_aggregates = any(entry.get("run_type") == "aggregate" for entry in entries)
+    results = {}
+    for entry in entries:
+        if has_aggregates and entry.get("aggregate_name") != "median":
+            continue
+        # Пропускная способность: элементов в секунду, а если её нет — итераций в секунду
+        if "items_per_second" in entry:
+            throughput = entry["items_per_second"]
+        else:
+            throughput = 1.0 / (entry["real_time"] * TIME_UNITS[entry["time_unit"]])
+        results[entry["run_name"]] = throughput
+    if not results:
+        sys.exit("no benchmarks matched filter %r" % bench_filter)
+    return results
+
+
+def record(args):
+    results = run_benchmarks(args.bench, args.filter, args.repetitions)
+    with open(args.baseline, "w") as baseline:
+        json.dump({"filter": args.filter, "throughput": results}, baseline, indent=2, sort_keys=True)
+        baseline.write("\n")
+    print("recorded %d benchmarks to %s" % (len(results), args.baseline))
+    return 0
+
+
+def check(args):
+    try:
+        with open(args.baseline) as baseline:
+            expected = json.load(baseline)
+    except FileNotFoundError:
+        sys.exit("baseline %s not found; record it first (target perf_baseline)" % args.baseline)
+
+    actual = run_benchmarks(args.bench, expected["filter"], args.repetitions)
+    failures = 0
+    for name, before in sorted(expected["throughput"].items()):
+        after = actual.get(name)
+        if after is None:
+            print("MISSING  %s" % name)
+            failures += 1
+            continue
+        change = (after - before) / before * 100.0
+        regressed = change < -args.tolerance
+        failures += regressed
+        print("%-8s %-60s %+7.1f%%" % ("REGRESS" if regressed else "ok", name, change))
+
+    if failures:
+        print("%d benchmarks regressed by more than %.1f%%" % (failures, args.tolerance))
+        return 1
+    print("all %d benchmarks within %.1f%% of baseline" % (len(expected["throughput"]), args.tolerance))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("mode", choices=["record", "check"])
+    parser.add_argument("--bench", required=True, help="path to simple_vector_bench")
+    parser.add_argument("--baseline", required=True, help="baseline JSON file")
+    parser.add_argument("--filter", default=DEFAULT_FILTER, help="benchmark filter regex (record only)")
+    parser.add_argument("--tolerance", type=float, default=10.0, help="allowed throughput drop, percent")
+    parser.add_argument("--repetitions", type=int, default=5)
+    args = parser.parse_args()
+    return record(args) if args.mode == "record" else check(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include "simple_vector.h"
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Аллокатор поверх malloc/realloc/free. Рост буфера с тривиально переносимыми элементами
+// идёт через realloc: крупные блоки glibc отображает через mmap и растит mremap-ом,
+// а блок у края кучи расширяется на месте, так что данные часто вообще не копируются.
+// TryExtend занимает хвост блока, который malloc и так выделил сверх запрошенного
+template <typename Type>
+class ReallocAllocator {
+    static_assert(alignof(Type) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+
+public:
+    using value_type = Type;
+
+    ReallocAllocator() noexcept = default;
+
+    template <typename Other>
+    ReallocAllocator(const ReallocAllocator<Other>&) noexcept {}
+
+    Type* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        void* ptr = std::malloc(n * sizeof(Type));
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<Type*>(ptr);
+    }
+
+    void deallocate(Type* ptr, size_t /*n*/) noexcept {
+        std::free(ptr);
+    }
+
+    bool TryExtend(Type* ptr, size_t /*n*/, size_t new_n) noexcept {
+#if defined(__GLIBC__)
+        return new_n <= std::numeric_limits<size_t>::max() / sizeof(Type)
+            && new_n * sizeof(Type) <= ::malloc_usable_size(ptr);
+#else
+        (void)ptr;
+        (void)new_n;
+        return false;
+#endif
+    }
+
+    // SimpleVector вызывает только для тривиально переносимых элементов (kReallocateBitwise)
+    Type* Reallocate(Type* ptr, size_t /*n*/, size_t new_n) noexcept {
+        if (new_n > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            return nullptr;
+        }
+        return static_cast<Type*>(std::realloc(static_cast<void*>(ptr), new_n * sizeof(Type)));
+    }
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const ReallocAllocator<Lhs>&, const ReallocAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const ReallocAllocator<Lhs>&, const ReallocAllocator<Rhs>&) noexcept {
+    return false;
+}
+
+// Вектор, растущий через realloc
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using ReallocSimpleVector = SimpleVector<Type, ReallocAllocator<Type>, GrowthPolicy>;
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Тип можно перенести в другой буфер побайтово: memcpy на новое место, а исходный
+// объект просто забыть, не вызывая деструктор. Верно для тривиально копируемых типов;
+// свои типы без указателей на себя (владеющие дескрипторы вроде unique_ptr)
+// подключаются специализацией:
+//     template <> struct IsTriviallyRelocatable<Handle> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+// Способ переноса элементов при перевыделении буфера:
+// побайтово для тривиально переносимых типов, перемещением, если оно noexcept
+// (или копирование недоступно), и копированием в остальных случаях,
+// чтобы при исключении старый буфер остался нетронутым.
+template <typename Type>
+inline constexpr bool kRelocateBitwise = IsTriviallyRelocatable<Type>::value;
+
+// Сдвиг внутри буфера оставляет на старых местах побайтовые копии, которые затем
+// присваиваются или разрушаются, — это допустимо только для тривиально копируемых типов
+template <typename Type>
+inline constexpr bool kShiftBitwise = std::is_trivially_copyable_v<Type>;
+
+template <typename Type>
+inline constexpr bool kRelocateByMove =
+    std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>;
+
+// Перенос не бросает исключений: побайтовый или через noexcept-перемещение
+template <typename Type>
+inline constexpr bool kRelocateNothrow = kRelocateBitwise<Type> || std::is_nothrow_move_constructible_v<Type>;
+
+// Создаёт в неинициализированной памяти dest копии/перемещённые версии count элементов src.
+// Исходные элементы остаются живыми, их разрушает вызывающий код через DestroyRelocated.
+template <typename Type>
+void UninitializedRelocate(Type* src, size_t count, Type* dest) {
+    if constexpr (kRelocateBitwise<Type>) {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+        }
+    }
+    else if constexpr (kRelocateByMove<Type>) {
+        std::uninitialized_move_n(src, count, dest);
+    }
+    else {
+        std::uninitialized_copy_n(src, count, dest);
+    }
+}
+
+// Разрушает исходные элементы после успешного UninitializedRelocate.
+// После побайтового переноса исходные объекты уже не живут, и разрушать нечего
+template <typename Type>
+void DestroyRelocated(Type* src, size_t count) noexcept {
+    if constexpr (!kRelocateBitwise<Type> && !std::is_trivially_destructible_v<Type>) {
+        std::destroy_n(src, count);
+    }
+}
+
+// Отменяет UninitializedRelocate, когда перенос остального не удался и
+// владельцем снова становится старый буфер: копии в dest разрушаются,
+// а побайтовые копии просто забываются, иначе ресурс освободился бы дважды
+template <typename Type>
+void DiscardRelocated(Type* dest, size_t count) noexcept {
+    if constexpr (!kRelocateBitwise<Type>) {
+        std::destroy_n(dest, count);
+    }
+}
+
+// Сдвигает count живых элементов с позиции first на одну вправо внутри буфера.
+// Слот first + count должен быть неинициализирован; после вызова в слоте first
+// остаётся объект, пригодный для присваивания.
+template <typename Type>
+void ShiftRightByOne(Type* first, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if constexpr (kShiftBitwise<Type>) {
+        std::memmove(static_cast<void*>(first + 1), static_cast<const void*>(first), count * sizeof(Type));
+    }
+    else {
+        Type* last = first + count;
+        ::new (static_cast<void*>(last)) Type(std::move(*(last - 1)));
+        try {
+            std::move_backward(first, last - 1, last);
+        }
+        catch (...) {
+            std::destroy_at(last);
+            throw;
+        }
+    }
+}
+
+// Сдвигает count живых элементов с позиции first + distance на distance влево (поверх first)
+template <typename Type>
+void ShiftLeft(Type* first, size_t count, size_t distance) {
+    if (count == 0 || distance == 0) {
+        return;
+    }
+    if constexpr (kShiftBitwise<Type>) {
+        std::memmove(static_cast<void*>(first), static_cast<const void*>(first + distance), count * sizeof(Type));
+    }
+    else {
+        std::move(first + distance, first + distance + count, first);
+    }
+}
@@ -0,0 +1,530 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Число элементов в сегменте по умолчанию: наибольшая степень двойки,
+// при которой сегмент занимает не больше Bytes байт (и не меньше одного элемента)
+template <typename Type, size_t Bytes = size_t{64} << 10>
+constexpr size_t DefaultSegmentSize() noexcept {
+    size_t size = 1;
+    while (size * 2 * sizeof(Type) <= Bytes) {
+        size *= 2;
+    }
+    return size;
+}
+
+// Вектор из сегментов фиксированного размера SegmentSize и таблицы указателей на них.
+// Рост добавляет один сегмент и никогда не переносит элементы: пиковая память не превышает
+// размер данных плюс сегмент, нет долгой остановки на копирование, а ссылки и указатели
+// на элементы остаются верными до их удаления. Итераторы ссылаются на таблицу сегментов
+// и становятся неверными, когда она растёт (при добавлении нового сегмента).
+// Доступ по индексу — O(1): сдвиг и маска, потому что SegmentSize — степень двойки
+template <typename Type, size_t SegmentSize = DefaultSegmentSize<Type>()>
+class SegmentedSimpleVector {
+    static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be a power of two");
+
+    static constexpr size_t kMask = SegmentSize - 1;
+    static constexpr size_t kShift = [] {
+        size_t shift = 0;
+        while ((size_t{1} << shift) != SegmentSize) {
+            ++shift;
+        }
+        return shift;
+    }();
+
+    using Storage = ArrayPtr<Type>;
+
+    template <bool IsConst>
+    class BasicIterator {
+        using SegmentPtr = std::conditional_t<IsConst, const Storage*, Storage*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() noexcept = default;
+
+        // Неконстантный итератор приводится к константному
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : segments_(other.segments_), index_(other.index_) {}
+
+        reference operator*() const noexcept {
+            return segments_[index_ >> kShift].Get()[index_ & kMask];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        friend class SegmentedSimpleVector;
+        friend class BasicIterator<!IsConst>;
+
+        BasicIterator(SegmentPtr segments, size_t index) noexcept
+            : segments_(segments), index_(index) {}
+
+        SegmentPtr segments_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    static constexpr size_t kSegmentSize = SegmentSize;
+
+    SegmentedSimpleVector() noexcept = default;
+
+    // Конструктор с заданным размером
+    explicit SegmentedSimpleVector(size_t size) {
+        ConstructGuarded([&] {
+            Resize(size);
+        });
+    }
+
+    // Конструктор с заданным размером и значением
+    SegmentedSimpleVector(size_t size, const Type& value) {
+        ConstructGuarded([&] {
+            GrowBy(size, [&value](Type* slot, size_t count) {
+                std::uninitialized_fill_n(slot, count, value);
+            });
+        });
+    }
+
+    // Конструктор с initializer_list
+    SegmentedSimpleVector(std::initializer_list<Type> init) {
+        ConstructGuarded([&] {
+            Append(init.begin(), init.end());
+        });
+    }
+
+    SegmentedSimpleVector(const SegmentedSimpleVector& other) {
+        ConstructGuarded([&] {
+            Append(other.begin(), other.end());
+        });
+    }
+
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : segments_(std::move(other.segments_)), size_(std::exchange(other.size_, 0)) {}
+
+    ~SegmentedSimpleVector() {
+        Clear();
+    }
+
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& other) {
+        if (this != &other) {
+            SegmentedSimpleVector tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            segments_ = std::move(other.segments_);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    // Оператор индексирования
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_ && "Index out of range");
+        return segments_[index >> kShift].Get()[index & kMask];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_ && "Index out of range");
+        return segments_[index >> kShift].Get()[index & kMask];
+    }
+
+    // Метод At с проверкой границ
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    Type& Back() noexcept {
+        assert(size_ > 0 && "Back called on an empty container");
+        return (*this)[size_ - 1];
+    }
+
+    const Type& Back() const noexcept {
+        assert(size_ > 0 && "Back called on an empty container");
+        return (*this)[size_ - 1];
+    }
+
+    // Итераторы
+    Iterator begin() noexcept {
+        return {segments_.begin(), 0};
+    }
+
+    Iterator end() noexcept {
+        return {segments_.begin(), size_};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {segments_.begin(), 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {segments_.begin(), size_};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Получение размера
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Ёмкость — все выделенные сегменты
+    size_t GetCapacity() const noexcept {
+        return segments_.GetSize() * SegmentSize;
+    }
+
+    // Число сегментов, в которых есть элементы
+    size_t GetSegmentCount() const noexcept {
+        return (size_ + kMask) >> kShift;
+    }
+
+    // Проверка на пустоту
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Непрерывный участок элементов сегмента index
+    SimpleVectorView<Type> Segment(size_t index) noexcept {
+        assert(index < GetSegmentCount() && "Segment index out of range");
+        return {segments_[index].Get(), SegmentLength(index)};
+    }
+
+    SimpleVectorView<const Type> Segment(size_t index) const noexcept {
+        assert(index < GetSegmentCount() && "Segment index out of range");
+        return {segments_[index].Get(), SegmentLength(index)};
+    }
+
+    // Обход по сегментам: func получает SimpleVectorView каждого непустого сегмента.
+    // Внутренний цикл идёт по непрерывной памяти и векторизуется, в отличие от обхода итераторами
+    template <typename Func>
+    void ForEachSegment(Func&& func) {
+        for (size_t i = 0; i < GetSegmentCount(); ++i) {
+            func(Segment(i));
+        }
+    }
+
+    template <typename Func>
+    void ForEachSegment(Func&& func) const {
+        for (size_t i = 0; i < GetSegmentCount(); ++i) {
+            func(Segment(i));
+        }
+    }
+
+    // Добавление элемента в конец. Ссылки на прежние элементы остаются верными
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            AddSegment();
+        }
+        Type* slot = segments_[size_ >> kShift].Get() + (size_ & kMask);
+        ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    // Добавление диапазона в конец, посегментно
+    template <typename InputIt>
+    void Append(InputIt first, InputIt last) {
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>) {
+            GrowBy(static_cast<size_t>(std::distance(first, last)), [&first](Type* slot, size_t count) {
+                InputIt next = std::next(first, count);
+                std::uninitialized_copy(first, next, slot);
+                first = next;
+            });
+        }
+        else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // Удаление последнего элемента; сегмент остаётся в запасе
+    void PopBack() noexcept {
+        assert(size_ > 0 && "PopBack called on an empty container");
+        --size_;
+        std::destroy_at(segments_[size_ >> kShift].Get() + (size_ & kMask));
+    }
+
+    // Изменение размера; новые элементы инициализируются значением по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            ShrinkTo(new_size);
+        }
+        else {
+            GrowBy(new_size - size_, [](Type* slot, size_t count) {
+                std::uninitialized_value_construct_n(slot, count);
+            });
+        }
+    }
+
+    // Выделяет сегменты под new_capacity элементов заранее; элементы не переносятся
+    void Reserve(size_t new_capacity) {
+        const size_t segments = (new_capacity + kMask) >> kShift;
+        if (segments > segments_.GetSize()) {
+            segments_.Reserve(segments);
+            while (segments_.GetSize() < segments) {
+                segments_.EmplaceBack(SegmentSize);
+            }
+        }
+    }
+
+    // Очистка вектора; сегменты остаются в запасе
+    void Clear() noexcept {
+        ShrinkTo(0);
+    }
+
+    // Освобождает запасные сегменты. Возвращает число освобождённых байт
+    size_t ShrinkToFit() noexcept {
+        const size_t spare = segments_.GetSize() - GetSegmentCount();
+        segments_.Resize(GetSegmentCount());
+        return spare * SegmentSize * sizeof(Type);
+    }
+
+    // Копия элементов в обычном непрерывном SimpleVector, одним выделением памяти
+    SimpleVector<Type> ToContiguous() const& {
+        SimpleVector<Type> result(::Reserve(size_));
+        ForEachSegment([&result](SimpleVectorView<const Type> segment) {
+            result.Append(segment.begin(), segment.end());
+        });
+        return result;
+    }
+
+    // Переносит элементы в SimpleVector. Непрерывный буфер выделяется сразу целиком, пока
+    // все сегменты ещё живы, поэтому пиковая память — примерно вдвое больше данных.
+    // Если перемещение не бросает исключений, сегменты освобождаются по мере переноса
+    SimpleVector<Type> ToContiguous() && {
+        SimpleVector<Type> result(::Reserve(size_));
+        for (size_t i = 0; i < GetSegmentCount(); ++i) {
+            SimpleVectorView<Type> segment = Segment(i);
+            result.Append(std::make_move_iterator(segment.begin()), std::make_move_iterator(segment.end()));
+            if constexpr (std::is_nothrow_move_constructible_v<Type>) {
+                std::destroy(segment.begin(), segment.end());
+                segments_[i] = Storage();
+            }
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<Type>) {
+            size_ = 0;
+            segments_.Clear();
+        }
+        else {
+            Clear();
+            ShrinkToFit();
+        }
+        return result;
+    }
+
+    // Обмен с другим вектором: меняются только таблицы сегментов
+    void swap(SegmentedSimpleVector& other) noexcept {
+        segments_.swap(other.segments_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    SimpleVector<Storage> segments_; // Таблица сегментов; её рост переносит только указатели
+    size_t size_ = 0;
+
+    // Деструктор недостроенного объекта не вызывается: созданные элементы разрушаются здесь
+    template <typename Body>
+    void ConstructGuarded(Body&& body) {
+        try {
+            body();
+        }
+        catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    size_t SegmentLength(size_t index) const noexcept {
+        return std::min(SegmentSize, size_ - (index << kShift));
+    }
+
+    void AddSegment() {
+        segments_.EmplaceBack(SegmentSize);
+    }
+
+    // Дописывает count элементов; construct(slot, n) создаёт n элементов в slot внутри одного сегмента.
+    // size_ обновляется после каждого сегмента, поэтому при исключении
+    // уже созданные элементы остаются в векторе и будут корректно разрушены
+    template <typename Constructor>
+    void GrowBy(size_t count, Constructor&& construct) {
+        Reserve(size_ + count);
+        size_t done = 0;
+        while (done < count) {
+            const size_t offset = size_ & kMask;
+            const size_t chunk = std::min(count - done, SegmentSize - offset);
+            construct(segments_[size_ >> kShift].Get() + offset, chunk);
+            size_ += chunk;
+            done += chunk;
+        }
+    }
+
+    // Разрушает элементы [new_size, size_) посегментно, с конца
+    void ShrinkTo(size_t new_size) noexcept {
+        while (size_ > new_size) {
+            const size_t segment_begin = (size_ - 1) & ~kMask;
+            const size_t from = std::max(segment_begin, new_size);
+            Type* base = segments_[segment_begin >> kShift].Get();
+            std::destroy(base + (from - segment_begin), base + (size_ - segment_begin));
+            size_ = from;
+        }
+    }
+};
+
+// Операторы сравнения
+
+template <typename Type, size_t SegmentSize>
+bool operator==(const SegmentedSimpleVector<Type, SegmentSize>& lhs, const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t SegmentSize>
+bool operator!=(const SegmentedSimpleVector<Type, SegmentSize>& lhs, const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t SegmentSize>
+bool operator<(const SegmentedSimpleVector<Type, SegmentSize>& lhs, const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, size_t SegmentSize>
+bool operator>(const SegmentedSimpleVector<Type, SegmentSize>& lhs, const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t SegmentSize>
+bool operator<=(const SegmentedSimpleVector<Type, SegmentSize>& lhs, const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, size_t SegmentSize>
+bool operator>=(const SegmentedSimpleVector<Type, SegmentSize>& lhs, const SegmentedSimpleVector<Type, SegmentSize>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Ядра сравнения и поиска по непрерывным диапазонам.
+// Для арифметических типов используются memcmp/memchr и векторные циклы
+// (AVX2 с выбором во время выполнения на x86-64, NEON на AArch64),
+// для остальных типов — обычные алгоритмы стандартной библиотеки.
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SIMPLE_VECTOR_HAS_AVX2 1
+#include <immintrin.h>
+#define SIMPLE_VECTOR_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__)
+#define SIMPLE_VECTOR_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Целые сравниваются побайтно, равенство совпадает с равенством представлений
+template <typename T>
+inline constexpr bool kSimdIntegral = std::is_integral_v<T>;
+
+template <typename T>
+inline constexpr bool kSimdFloating = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+#if defined(SIMPLE_VECTOR_HAS_AVX2)
+
+inline bool CpuHasAvx2() noexcept {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+// Индекс первого различающегося байта или n
+SIMPLE_VECTOR_TARGET_AVX2 inline size_t Avx2MismatchBytes(const unsigned char* a, const unsigned char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Маска байтов, в которых элементы chunk равны value (по sizeof(T) битов на элемент)
+template <typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline unsigned Avx2EqualMask(const T* chunk, T value) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+    if constexpr (sizeof(T) == 1) {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(value))));
+    }
+    else if constexpr (sizeof(T) == 2) {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi16(v, _mm256_set1_epi16(static_cast<short>(value))));
+    }
+    else if constexpr (sizeof(T) == 4) {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi32(v, _mm256_set1_epi32(static_cast<int>(value))));
+    }
+    else {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi64(v, _mm256_set1_epi64x(static_cast<long long>(value))));
+    }
+}
+
+template <typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline size_t Avx2FindIntegral(const T* data, size_t n, T value) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        const unsigned mask = Avx2EqualMask(data + i, value);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+    for (; i < n; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline size_t Avx2CountIntegral(const T* data, size_t n, T value) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        count += __builtin_popcount(Avx2EqualMask(data + i, value)) / sizeof(T);
+    }
+    for (; i < n; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+// Маска элементов, для которых сравнение kPredicate истинно (один бит на элемент)
+template <int kPredicate, typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline unsigned Avx2FloatMask(const T* lhs, const T* rhs) {
+    if constexpr (std::is_same_v<T, float>) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(lhs), _mm256_loadu_ps(rhs), kPredicate));
+    }
+    else {
+        return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(lhs), _mm256_loadu_pd(rhs), kPredicate));
+    }
+}
+
+template <typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline size_t Avx2MismatchFloating(const T* a, const T* b, size_t n) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        const unsigned mask = Avx2FloatMask<_CMP_NEQ_UQ>(a + i, b + i);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n; ++i) {
+        if (!(a[i] == b[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline size_t Avx2FindFloating(const T* data, size_t n, T value) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    T needle[kLanes];
+    std::fill_n(needle, kLanes, value);
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        const unsigned mask = Avx2FloatMask<_CMP_EQ_OQ>(data + i, needle);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+SIMPLE_VECTOR_TARGET_AVX2 inline size_t Avx2CountFloating(const T* data, size_t n, T value) {
+    constexpr size_t kLanes = 32 / sizeof(T);
+    T needle[kLanes];
+    std::fill_n(needle, kLanes, value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        count += __builtin_popcount(Avx2FloatMask<_CMP_EQ_OQ>(data + i, needle));
+    }
+    for (; i < n; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+
+inline size_t NeonMismatchBytes(const unsigned char* a, const unsigned char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        if (vminvq_u8(vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i))) != 0xFF) {
+            break; // Точную позицию внутри блока найдёт скалярный хвост
+        }
+    }
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+inline size_t NeonFindIntegral(const T* data, size_t n, T value) {
+    constexpr size_t kLanes = 16 / sizeof(T);
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint8x16_t equal;
+        if constexpr (sizeof(T) == 1) {
+            equal = vceqq_u8(chunk, vdupq_n_u8(static_cast<uint8_t>(value)));
+        }
+        else if constexpr (sizeof(T) == 2) {
+            equal = vreinterpretq_u8_u16(
+                vceqq_u16(vreinterpretq_u16_u8(chunk), vdupq_n_u16(static_cast<uint16_t>(value))));
+        }
+        else if constexpr (sizeof(T) == 4) {
+            equal = vreinterpretq_u8_u32(
+                vceqq_u32(vreinterpretq_u32_u8(chunk), vdupq_n_u32(static_cast<uint32_t>(value))));
+        }
+        else {
+            equal = vreinterpretq_u8_u64(
+                vceqq_u64(vreinterpretq_u64_u8(chunk), vdupq_n_u64(static_cast<uint64_t>(value))));
+        }
+        if (vmaxvq_u8(equal) != 0) {
+            break;
+        }
+    }
+    for (; i < n; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#endif
+
+// Индекс первой позиции, где !(a[i] == b[i]), или n
+template <typename T>
+size_t RangeMismatch(const T* a, const T* b, size_t n) {
+    if constexpr (kSimdIntegral<T>) {
+        const auto* a_bytes = reinterpret_cast<const unsigned char*>(a);
+        const auto* b_bytes = reinterpret_cast<const unsigned char*>(b);
+#if defined(SIMPLE_VECTOR_HAS_AVX2)
+        if (CpuHasAvx2()) {
+            return Avx2MismatchBytes(a_bytes, b_bytes, n * sizeof(T)) / sizeof(T);
+        }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+        return NeonMismatchBytes(a_bytes, b_bytes, n * sizeof(T)) / sizeof(T);
+#endif
+    }
+#if defined(SIMPLE_VECTOR_HAS_AVX2)
+    if constexpr (kSimdFloating<T>) {
+        if (CpuHasAvx2()) {
+            return Avx2MismatchFloating(a, b, n);
+        }
+    }
+#endif
+    return std::mismatch(a, a + n, b).first - a;
+}
+
+// std::equal для диапазонов одинаковой длины n
+template <typename T>
+bool RangeEqual(const T* a, const T* b, size_t n) {
+    if constexpr (kSimdIntegral<T>) {
+        return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+    }
+    else if constexpr (kSimdFloating<T>) {
+        return RangeMismatch(a, b, n) == n;
+    }
+    else {
+        return std::equal(a, a + n, b);
+    }
+}
+
+// std::lexicographical_compare для [a, a + a_size) и [b, b + b_size)
+template <typename T>
+bool RangeLess(const T* a, size_t a_size, const T* b, size_t b_size) {
+    const size_t common = std::min(a_size, b_size);
+    if constexpr (kSimdIntegral<T> && sizeof(T) == 1 && std::is_unsigned_v<T>) {
+        // memcmp сравнивает байты как unsigned char, что совпадает с порядком элементов
+        const int order = common == 0 ? 0 : std::memcmp(a, b, common);
+        return order < 0 || (order == 0 && a_size < b_size);
+    }
+    else if constexpr (kSimdIntegral<T>) {
+        const size_t index = RangeMismatch(a, b, common);
+        return index == common ? a_size < b_size : a[index] < b[index];
+    }
+    else {
+        // Для чисел с плавающей точкой NaN эквивалентен всему, поэтому == не годится для поиска различия
+        return std::lexicographical_compare(a, a + a_size, b, b + b_size);
+    }
+}
+
+// Индекс первого элемента, равного value, или n
+template <typename T>
+size_t RangeFind(const T* data, size_t n, const T& value) {
+    if constexpr (kSimdIntegral<T> && sizeof(T) == 1) {
+        const void* found = n == 0 ? nullptr : std::memchr(data, static_cast<unsigned char>(value), n);
+        return found == nullptr ? n : static_cast<const T*>(found) - data;
+    }
+#if defined(SIMPLE_VECTOR_HAS_AVX2)
+    if constexpr (kSimdIntegral<T>) {
+        if (CpuHasAvx2()) {
+            return Avx2FindIntegral(data, n, value);
+        }
+    }
+    if constexpr (kSimdFloating<T>) {
+        if (CpuHasAvx2()) {
+            return Avx2FindFloating(data, n, value);
+        }
+    }
+#elif defined(SIMPLE_VECTOR_HAS_NEON)
+    if constexpr (kSimdIntegral<T>) {
+        return NeonFindIntegral(data, n, value);
+    }
+#endif
+    return std::find(data, data + n, value) - data;
+}
+
+// Количество элементов, равных value
+template <typename T>
+size_t RangeCount(const T* data, size_t n, const T& value) {
+#if defined(SIMPLE_VECTOR_HAS_AVX2)
+    if constexpr (kSimdIntegral<T>) {
+        if (CpuHasAvx2()) {
+            return Avx2CountIntegral(data, n, value);
+        }
+    }
+    if constexpr (kSimdFloating<T>) {
+        if (CpuHasAvx2()) {
+            return Avx2CountFloating(data, n, value);
+        }
+    }
+#endif
+    // Простой цикл подсчёта компилятор векторизует сам
+    return static_cast<size_t>(std::count(data, data + n, value));
+}
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Индекс первого элемента отсортированного массива, не меньшего key.
+// Поиск без ветвлений: на каждом шаге половина отбрасывается условной пересылкой,
+// число итераций зависит только от size, и предсказателю переходов нечего угадывать
+template <typename Key, typename Compare>
+size_t BranchlessLowerBound(const Key* data, size_t size, const Key& key, const Compare& comp) {
+    if (size == 0) {
+        return 0;
+    }
+    const Key* first = data;
+    while (size > 1) {
+        const size_t half = size / 2;
+        first = comp(first[half], key) ? first + half : first;
+        size -= half;
+    }
+    return static_cast<size_t>(first - data) + static_cast<size_t>(comp(*first, key));
+}
+
+// Порядок слияния двух отсортированных последовательностей без повторов. Индекс i < lhs_size
+// означает элемент первой последовательности, иначе — элемент i - lhs_size второй;
+// key(i) возвращает ключ по такому индексу. Из равных остаётся элемент первой, затем первый
+// из второй. Только сравнивает и ничего не перемещает, поэтому исключение компаратора
+// не портит исходные последовательности
+template <typename KeyOf, typename Compare>
+SimpleVector<size_t> MergeUniqueOrder(size_t lhs_size, size_t rhs_size, const KeyOf& key, const Compare& comp) {
+    SimpleVector<size_t> order(Reserve(lhs_size + rhs_size));
+    const size_t end = lhs_size + rhs_size;
+    size_t lhs = 0;
+    size_t rhs = lhs_size;
+    while (lhs < lhs_size || rhs < end) {
+        const size_t next = rhs == end || (lhs < lhs_size && !comp(key(rhs), key(lhs))) ? lhs++ : rhs++;
+        if (order.IsEmpty() || comp(key(order[order.GetSize() - 1]), key(next))) {
+            order.PushBack(next);
+        }
+    }
+    return order;
+}
+
+// Множество на отсортированном SimpleVector: элементы лежат подряд, поиск — бинарный
+// без ветвлений. Вставка и удаление одного элемента — O(n), поэтому наполнять
+// множество лучше пачкой через InsertSorted. Итераторы только константные
+template <typename Key, typename Compare = std::less<Key>>
+class SimpleFlatSet {
+public:
+    using Iterator = const Key*;
+    using ConstIterator = const Key*;
+
+    SimpleFlatSet() = default;
+
+    explicit SimpleFlatSet(const Compare& comp)
+        : comp_(comp) {}
+
+    SimpleFlatSet(std::initializer_list<Key> init, const Compare& comp = Compare())
+        : comp_(comp) {
+        InsertSorted(init.begin(), init.end());
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return keys_.cbegin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return keys_.cend();
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Все элементы по возрастанию
+    ConstSimpleVectorView<Key> Keys() const noexcept {
+        return keys_;
+    }
+
+    ConstIterator LowerBound(const Key& key) const {
+        return begin() + BranchlessLowerBound(keys_.begin(), GetSize(), key, comp_);
+    }
+
+    // Итератор на элемент, равный key, или end()
+    ConstIterator Find(const Key& key) const {
+        const ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Вставляет key, если его ещё нет. Возвращает итератор на элемент и признак вставки
+    std::pair<ConstIterator, bool> Insert(Key key) {
+        const size_t index = BranchlessLowerBound(keys_.begin(), GetSize(), key, comp_);
+        if (index != GetSize() && !comp_(key, keys_[index])) {
+            return {begin() + index, false};
+        }
+        return {keys_.Insert(keys_.cbegin() + index, std::move(key)), true};
+    }
+
+    // Вставка диапазона за один проход: новые элементы дописываются в конец, сортируются
+    // и сливаются с прежними в новый массив без повторов. O((n + m) + m log m) вместо O(n * m)
+    // у поэлементной вставки. Из равных остаётся прежний элемент, затем первый из диапазона.
+    // При исключении множество остаётся прежним
+    template <typename InputIt>
+    void InsertSorted(InputIt first, InputIt last) {
+        const size_t old_size = GetSize();
+        try {
+            keys_.Append(first, last);
+            std::stable_sort(keys_.begin() + old_size, keys_.end(), comp_);
+            const SimpleVector<size_t> order = MergeUniqueOrder(old_size, GetSize() - old_size, [this](size_t i) -> const Key& {
+                return keys_[i];
+            }, comp_);
+            SimpleVector<Key> merged(::Reserve(order.GetSize()));
+            for (const size_t source : order) {
+                merged.PushBack(std::move_if_noexcept(keys_[source]));
+            }
+            keys_.swap(merged);
+        }
+        catch (...) {
+            keys_.EraseRange(keys_.begin() + old_size, keys_.end()); // Прежние элементы не тронуты: сортировался только хвост
+            throw;
+        }
+    }
+
+    // Удаляет элемент, равный key. Возвращает число удалённых элементов
+    size_t Erase(const Key& key) {
+        const ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        keys_.Erase(it);
+        return 1;
+    }
+
+    ConstIterator Erase(ConstIterator pos) {
+        return keys_.Erase(pos);
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    void swap(SimpleFlatSet& other) noexcept {
+        keys_.swap(other.keys_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    SimpleVector<Key> keys_;
+    [[no_unique_address]] Compare comp_;
+};
+
+template <typename Key, typename Compare>
+bool operator==(const SimpleFlatSet<Key, Compare>& lhs, const SimpleFlatSet<Key, Compare>& rhs) {
+    return lhs.Keys() == rhs.Keys();
+}
+
+template <typename Key, typename Compare>
+bool operator!=(const SimpleFlatSet<Key, Compare>& lhs, const SimpleFlatSet<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+// Ассоциативный массив на двух SimpleVector: ключи и значения хранятся раздельно (SoA),
+// поэтому бинарный поиск проходит только по плотному массиву ключей, а значения
+// читаются один раз по найденному индексу. Элемент с индексом i — KeyAt(i) и ValueAt(i).
+// Указатели на значения становятся неверными после вставки и удаления
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class SimpleFlatMap {
+public:
+    SimpleFlatMap() = default;
+
+    explicit SimpleFlatMap(const Compare& comp)
+        : comp_(comp) {}
+
+    SimpleFlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& comp = Compare())
+        : comp_(comp) {
+        InsertSorted(init.begin(), init.end());
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Ключи по возрастанию и значения в том же порядке
+    ConstSimpleVectorView<Key> Keys() const noexcept {
+        return keys_;
+    }
+
+    SimpleVectorView<Value> Values() noexcept {
+        return values_;
+    }
+
+    ConstSimpleVectorView<Value> Values() const noexcept {
+        return values_;
+    }
+
+    const Key& KeyAt(size_t index) const {
+        return keys_.At(index);
+    }
+
+    Value& ValueAt(size_t index) {
+        return values_.At(index);
+    }
+
+    const Value& ValueAt(size_t index) const {
+        return values_.At(index);
+    }
+
+    // Значение по ключу или nullptr
+    Value* Find(const Key& key) {
+        const size_t index = IndexOf(key);
+        return index == GetSize() ? nullptr : &values_[index];
+    }
+
+    const Value* Find(const Key& key) const {
+        const size_t index = IndexOf(key);
+        return index == GetSize() ? nullptr : &values_[index];
+    }
+
+    bool Contains(const Key& key) const {
+        return IndexOf(key) != GetSize();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Метод At с проверкой наличия ключа
+    Value& At(const Key& key) {
+        if (Value* value = Find(key)) {
+            return *value;
+        }
+        throw std::out_of_range("Key not found");
+    }
+
+    const Value& At(const Key& key) const {
+        if (const Value* value = Find(key)) {
+            return *value;
+        }
+        throw std::out_of_range("Key not found");
+    }
+
+    // Значение по ключу; отсутствующий ключ вставляется со значением по умолчанию
+    Value& operator[](const Key& key) {
+        return *TryEmplace(key).first;
+    }
+
+    // Вставляет пару, если ключа ещё нет. Возвращает значение по ключу и признак вставки
+    std::pair<Value*, bool> Insert(Key key, Value value) {
+        return TryEmplace(std::move(key), std::move(value));
+    }
+
+    // Создаёт значение из args, только если ключа ещё нет
+    template <typename... Args>
+    std::pair<Value*, bool> TryEmplace(Key key, Args&&... args) {
+        const size_t index = BranchlessLowerBound(keys_.begin(), GetSize(), key, comp_);
+        if (index != GetSize() && !comp_(key, keys_[index])) {
+            return {&values_[index], false};
+        }
+        values_.Emplace(values_.cbegin() + index, std::forward<Args>(args)...);
+        try {
+            keys_.Insert(keys_.cbegin() + index, std::move(key));
+        }
+        catch (...) {
+            values_.Erase(values_.cbegin() + index);
+            throw;
+        }
+        return {&values_[index], true};
+    }
+
+    // Вставка диапазона пар за один проход: новые пары сортируются по ключу и сливаются
+    // с прежними в новые массивы ключей и значений. Сначала по одним сравнениям строится
+    // порядок слияния, затем пары переносятся. Из пар с равными ключами остаётся прежняя,
+    // затем первая из диапазона. При исключении карта остаётся прежней (см. kMoveOldPairs)
+    template <typename InputIt>
+    void InsertSorted(InputIt first, InputIt last) {
+        SimpleVector<std::pair<Key, Value>> added;
+        added.Append(first, last);
+        std::stable_sort(added.begin(), added.end(), [this](const auto& lhs, const auto& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+
+        const size_t old_size = GetSize();
+        const SimpleVector<size_t> order = MergeUniqueOrder(old_size, added.GetSize(), [&](size_t i) -> const Key& {
+            return i < old_size ? keys_[i] : added[i - old_size].first;
+        }, comp_);
+
+        SimpleVector<Key> keys(::Reserve(order.GetSize()));
+        SimpleVector<Value> values(::Reserve(order.GetSize()));
+        for (const size_t source : order) {
+            if (source >= old_size) {
+                keys.PushBack(std::move(added[source - old_size].first));
+                values.PushBack(std::move(added[source - old_size].second));
+            }
+            else if constexpr (kMoveOldPairs) {
+                keys.PushBack(std::move(keys_[source]));
+                values.PushBack(std::move(values_[source]));
+            }
+            else {
+                keys.PushBack(keys_[source]);
+                values.PushBack(values_[source]);
+            }
+        }
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+
+    // Удаляет пару с ключом key. Возвращает число удалённых пар
+    size_t Erase(const Key& key) {
+        const size_t index = IndexOf(key);
+        if (index == GetSize()) {
+            return 0;
+        }
+        keys_.Erase(keys_.cbegin() + index);
+        values_.Erase(values_.cbegin() + index);
+        return 1;
+    }
+
+    // Обход пар по возрастанию ключей: func(const Key&, Value&)
+    template <typename Func>
+    void ForEach(Func&& func) {
+        for (size_t i = 0; i < GetSize(); ++i) {
+            func(keys_[i], values_[i]);
+        }
+    }
+
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (size_t i = 0; i < GetSize(); ++i) {
+            func(keys_[i], values_[i]);
+        }
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    void swap(SimpleFlatMap& other) noexcept {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    // Прежние пары перемещаются, только если перемещение не бросает ни в одном столбце.
+    // Иначе они копируются: сбой на значении не оставит перемещённым уже перенесённый ключ.
+    // Некопируемые типы перемещаются в любом случае, и гарантия для них базовая
+    static constexpr bool kMoveOldPairs =
+        (std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>)
+        || !std::is_copy_constructible_v<Key> || !std::is_copy_constructible_v<Value>;
+
+    SimpleVector<Key> keys_;
+    SimpleVector<Value> values_;
+    [[no_unique_address]] Compare comp_;
+
+    // Индекс ключа key или GetSize()
+    size_t IndexOf(const Key& key) const {
+        const size_t index = BranchlessLowerBound(keys_.begin(), GetSize(), key, comp_);
+        return index != GetSize() && !comp_(key, keys_[index]) ? index : GetSize();
+    }
+};
+
+template <typename Key, typename Value, typename Compare>
+bool operator==(const SimpleFlatMap<Key, Value, Compare>& lhs, const SimpleFlatMap<Key, Value, Compare>& rhs) {
+    return lhs.Keys() == rhs.Keys() && lhs.Values() == rhs.Values();
+}
+
+template <typename Key, typename Value, typename Compare>
+bool operator!=(const SimpleFlatMap<Key, Value, Compare>& lhs, const SimpleFlatMap<Key, Value, Compare>& rhs) {
+    return !(lhs == rhs);
+}
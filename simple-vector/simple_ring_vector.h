@@ -0,0 +1,599 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "parallel_algorithms.h"
+#include "relocate.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Наименьшая степень двойки, не меньшая value (для 0 — 1)
+inline size_t RoundUpToPowerOfTwo(size_t value) noexcept {
+    size_t result = 1;
+    while (result < value && result <= std::numeric_limits<size_t>::max() / 2) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Кольцевой вектор: очередь с двумя концами поверх ArrayPtr. Элементы занимают слоты
+// head_, head_ + 1, ... по модулю ёмкости, ёмкость — степень двойки, поэтому индекс слота
+// считается маской. PushFront, PopFront, PushBack и PopBack — O(1) без сдвига элементов.
+// Логический индекс i живёт в слоте (head_ + i) & mask; Linearize делает хранение непрерывным
+template <typename Type>
+class SimpleRingVector {
+    using Storage = ArrayPtr<Type>;
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SimpleRingVector, SimpleRingVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+        using reference = std::conditional_t<IsConst, const Type&, Type&>;
+
+        BasicIterator() noexcept = default;
+
+        // Неконстантный итератор приводится к константному
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+            : owner_(other.owner_), index_(other.index_) {}
+
+        reference operator*() const noexcept {
+            return *owner_->Slot(index_);
+        }
+
+        pointer operator->() const noexcept {
+            return owner_->Slot(index_);
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *owner_->Slot(index_ + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        friend class SimpleRingVector;
+        friend class BasicIterator<!IsConst>;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner), index_(index) {}
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    SimpleRingVector() noexcept = default;
+
+    // Пустой вектор ёмкостью не меньше capacity
+    explicit SimpleRingVector(ReserveProxyObj obj) {
+        Reserve(obj.GetCapacity());
+    }
+
+    // Конструктор с initializer_list
+    SimpleRingVector(std::initializer_list<Type> init) {
+        AppendGuarded(init.begin(), init.end(), init.size());
+    }
+
+    SimpleRingVector(const SimpleRingVector& other) {
+        AppendGuarded(other.begin(), other.end(), other.size_);
+    }
+
+    SimpleRingVector(SimpleRingVector&& other) noexcept
+        : data_(std::move(other.data_)),
+          head_(std::exchange(other.head_, 0)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    ~SimpleRingVector() {
+        Clear();
+    }
+
+    SimpleRingVector& operator=(const SimpleRingVector& other) {
+        if (this != &other) {
+            SimpleRingVector tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    SimpleRingVector& operator=(SimpleRingVector&& other) noexcept {
+        if (this != &other) {
+            Clear();
+            data_ = std::move(other.data_);
+            head_ = std::exchange(other.head_, 0);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    // Оператор индексирования
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_ && "Index out of range");
+        return *Slot(index);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_ && "Index out of range");
+        return *Slot(index);
+    }
+
+    // Метод At с проверкой границ
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *Slot(index);
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return *Slot(index);
+    }
+
+    Type& Front() noexcept {
+        assert(size_ > 0 && "Front called on an empty container");
+        return *Slot(0);
+    }
+
+    const Type& Front() const noexcept {
+        assert(size_ > 0 && "Front called on an empty container");
+        return *Slot(0);
+    }
+
+    Type& Back() noexcept {
+        assert(size_ > 0 && "Back called on an empty container");
+        return *Slot(size_ - 1);
+    }
+
+    const Type& Back() const noexcept {
+        assert(size_ > 0 && "Back called on an empty container");
+        return *Slot(size_ - 1);
+    }
+
+    // Итераторы
+    Iterator begin() noexcept {
+        return {this, 0};
+    }
+
+    Iterator end() noexcept {
+        return {this, size_};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {this, size_};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Получение размера
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Ёмкость — степень двойки или 0
+    size_t GetCapacity() const noexcept {
+        return data_.GetSize();
+    }
+
+    // Проверка на пустоту
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Элементы лежат в буфере подряд, без перехода через его конец
+    bool IsContiguous() const noexcept {
+        return head_ + size_ <= GetCapacity();
+    }
+
+    // Добавление элемента в конец
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            return GrowAndEmplace(false, std::forward<Args>(args)...);
+        }
+        Type* slot = Slot(size_);
+        ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    // Добавление элемента в начало
+    void PushFront(const Type& item) {
+        EmplaceFront(item);
+    }
+
+    void PushFront(Type&& item) {
+        EmplaceFront(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            return GrowAndEmplace(true, std::forward<Args>(args)...);
+        }
+        const size_t head = (head_ - 1) & Mask();
+        Type* slot = data_.Get() + head;
+        ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+        head_ = head;
+        ++size_;
+        return *slot;
+    }
+
+    // Удаление последнего элемента
+    void PopBack() noexcept {
+        assert(size_ > 0 && "PopBack called on an empty container");
+        --size_;
+        std::destroy_at(Slot(size_));
+    }
+
+    // Удаление первого элемента
+    void PopFront() noexcept {
+        assert(size_ > 0 && "PopFront called on an empty container");
+        std::destroy_at(Slot(0));
+        head_ = (head_ + 1) & Mask();
+        --size_;
+    }
+
+    // Очистка вектора; ёмкость сохраняется
+    void Clear() noexcept {
+        while (size_ > 0) {
+            PopBack();
+        }
+        head_ = 0;
+    }
+
+    // Ёмкость округляется до степени двойки
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(RoundUpToPowerOfTwo(new_capacity));
+        }
+    }
+
+    // Делает хранение непрерывным и возвращает вид на все элементы по порядку.
+    // Если элементы переходят через конец буфера, они переносятся в новый буфер той же ёмкости
+    SimpleVectorView<Type> Linearize() {
+        if (!IsContiguous()) {
+            Reallocate(GetCapacity());
+        }
+        return {data_.Get() + head_, size_};
+    }
+
+    // Элементы в виде двух непрерывных участков: от головы до конца буфера и с его начала
+    std::pair<SimpleVectorView<const Type>, SimpleVectorView<const Type>> GetRuns() const noexcept {
+        const size_t first = std::min(size_, GetCapacity() - head_);
+        return {{data_.Get() + head_, first}, {data_.Get(), size_ - first}};
+    }
+
+    // Обмен с другим вектором
+    void swap(SimpleRingVector& other) noexcept {
+        data_.swap(other.data_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    Storage data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    // Заполнение в конструкторе: деструктор недостроенного объекта не вызывается,
+    // поэтому созданные элементы разрушаются здесь
+    template <typename InputIt>
+    void AppendGuarded(InputIt first, InputIt last, size_t count) {
+        try {
+            Reserve(count);
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+        catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    size_t Mask() const noexcept {
+        return GetCapacity() - 1;
+    }
+
+    Type* Slot(size_t index) const noexcept {
+        return data_.Get() + ((head_ + index) & Mask());
+    }
+
+    // Переносит элементы в начало нового буфера сдвигом offset (0 или 1).
+    // При исключении новый буфер освобождается, а старый остаётся нетронутым
+    void RelocateInto(Storage& fresh, size_t offset) {
+        const auto [first, second] = GetRuns();
+        Type* src = data_.Get();
+        UninitializedRelocate(src + head_, first.GetSize(), fresh.Get() + offset);
+        try {
+            UninitializedRelocate(src, second.GetSize(), fresh.Get() + offset + first.GetSize());
+        }
+        catch (...) {
+            DiscardRelocated(fresh.Get() + offset, first.GetSize());
+            throw;
+        }
+    }
+
+    void CommitRelocation(Storage& fresh) noexcept {
+        const auto [first, second] = GetRuns();
+        DestroyRelocated(data_.Get() + head_, first.GetSize());
+        DestroyRelocated(data_.Get(), second.GetSize());
+        data_.swap(fresh);
+        head_ = 0;
+    }
+
+    void Reallocate(size_t new_capacity) {
+        Storage fresh(new_capacity);
+        RelocateInto(fresh, 0);
+        CommitRelocation(fresh);
+    }
+
+    // Рост вдвое с созданием нового элемента в начале или в конце нового буфера.
+    // Элемент создаётся первым: args могут ссылаться на элементы старого буфера
+    template <typename... Args>
+    Type& GrowAndEmplace(bool front, Args&&... args) {
+        const size_t new_capacity = GetCapacity() == 0 ? 1 : GetCapacity() * 2;
+        Storage fresh(new_capacity);
+        Type* slot = fresh.Get() + (front ? 0 : size_);
+        ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+        try {
+            RelocateInto(fresh, front ? 1 : 0);
+        }
+        catch (...) {
+            std::destroy_at(slot);
+            throw;
+        }
+        CommitRelocation(fresh);
+        ++size_;
+        return *slot;
+    }
+};
+
+// Операторы сравнения
+
+template <typename Type>
+bool operator==(const SimpleRingVector<Type>& lhs, const SimpleRingVector<Type>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type>
+bool operator!=(const SimpleRingVector<Type>& lhs, const SimpleRingVector<Type>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const SimpleRingVector<Type>& lhs, const SimpleRingVector<Type>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type>
+bool operator>(const SimpleRingVector<Type>& lhs, const SimpleRingVector<Type>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type>
+bool operator<=(const SimpleRingVector<Type>& lhs, const SimpleRingVector<Type>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type>
+bool operator>=(const SimpleRingVector<Type>& lhs, const SimpleRingVector<Type>& rhs) {
+    return !(lhs < rhs);
+}
+
+// Кольцевая очередь фиксированной ёмкости для одного производителя и одного потребителя
+// без блокировок. Производитель пишет только tail_, потребитель — только head_;
+// оба индекса растут монотонно и лежат на разных кэш-линиях, а каждая сторона
+// держит копию чужого индекса и перечитывает его, лишь когда копия говорит «полно» или «пусто».
+// TryPush/TryEmplace вызывает только поток-производитель, TryPop/TryFront — только потребитель
+template <typename Type>
+class SpscRingVector {
+public:
+    // Ёмкость округляется до степени двойки
+    explicit SpscRingVector(size_t capacity)
+        : data_(RoundUpToPowerOfTwo(capacity)), mask_(data_.GetSize() - 1) {}
+
+    ~SpscRingVector() {
+        const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        for (size_t head = consumer_.head.load(std::memory_order_relaxed); head != tail; ++head) {
+            std::destroy_at(Slot(head));
+        }
+    }
+
+    SpscRingVector(const SpscRingVector&) = delete;
+    SpscRingVector& operator=(const SpscRingVector&) = delete;
+
+    size_t GetCapacity() const noexcept {
+        return data_.GetSize();
+    }
+
+    // Приблизительный размер: точен, только когда обе стороны стоят
+    size_t GetSize() const noexcept {
+        const size_t head = consumer_.head.load(std::memory_order_acquire);
+        return producer_.tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool TryPush(const Type& item) {
+        return TryEmplace(item);
+    }
+
+    bool TryPush(Type&& item) {
+        return TryEmplace(std::move(item));
+    }
+
+    // Создаёт элемент в хвосте. false — очередь полна, args не тронуты
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        if (tail - producer_.cached_head == GetCapacity()) {
+            producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+            if (tail - producer_.cached_head == GetCapacity()) {
+                return false;
+            }
+        }
+        ::new (static_cast<void*>(Slot(tail))) Type(std::forward<Args>(args)...);
+        producer_.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Переносит голову очереди в out. false — очередь пуста
+    bool TryPop(Type& out) {
+        Type* front = TryFront();
+        if (front == nullptr) {
+            return false;
+        }
+        out = std::move(*front);
+        PopFront();
+        return true;
+    }
+
+    // Голова очереди без извлечения или nullptr. Указатель верен до PopFront
+    Type* TryFront() noexcept {
+        const size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if (head == consumer_.cached_tail) {
+            consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+            if (head == consumer_.cached_tail) {
+                return nullptr;
+            }
+        }
+        return Slot(head);
+    }
+
+    // Удаляет голову очереди; очередь не должна быть пуста (TryFront вернул элемент)
+    void PopFront() noexcept {
+        const size_t head = consumer_.head.load(std::memory_order_relaxed);
+        assert(head != consumer_.cached_tail && "PopFront called on an empty queue");
+        std::destroy_at(Slot(head));
+        consumer_.head.store(head + 1, std::memory_order_release);
+    }
+
+private:
+    struct alignas(kCacheLineSize) ProducerSide {
+        std::atomic<size_t> tail = 0;
+        size_t cached_head = 0;
+    };
+
+    struct alignas(kCacheLineSize) ConsumerSide {
+        std::atomic<size_t> head = 0;
+        size_t cached_tail = 0;
+    };
+
+    ArrayPtr<Type> data_;
+    size_t mask_;
+    ProducerSide producer_;
+    ConsumerSide consumer_;
+
+    Type* Slot(size_t index) const noexcept {
+        return data_.Get() + (index & mask_);
+    }
+};
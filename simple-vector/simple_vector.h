@@ -1,10 +1,19 @@
 #pragma once
 #include <cassert>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <algorithm>
 #include <utility> // Для std::move
 #include "array_ptr.h" // Подключаем ArrayPtr
+#include "growth_policy.h"
+#include "relocate.h"
+#include "simd_kernels.h"
+#include "simple_vector_stats.h"
 
 // Класс-объект для резервирования
 class ReserveProxyObj {
@@ -20,56 +29,87 @@ private:
     size_t capacity_;
 };
 
+// Позволяет ли итератор заранее узнать длину диапазона через std::distance
+template <typename It>
+inline constexpr bool kIsForwardIterator = std::is_base_of_v<
+    std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
 // Вспомогательная функция для создания ReserveProxyObj
 ReserveProxyObj Reserve(size_t capacity) {
     return ReserveProxyObj(capacity);
 }
 
-template <typename Type>
+// Stats — политика статистики выделений (см. simple_vector_stats.h). NoVectorStats ничего не стоит
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          typename Stats = NoVectorStats>
 class SimpleVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Storage = ArrayPtr<Type, Allocator>;
+
+    // Аллокатор переносит блок сам (как realloc), без поэлементного копирования
+    static constexpr bool kReallocateBitwise = kRelocateBitwise<Type> && kAllocatorCanReallocate<Allocator>;
+
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
+    using allocator_type = Allocator;
 
     // Конструктор по умолчанию
-    SimpleVector() noexcept = default;
+    SimpleVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+
+    // Пустой вектор с заданным аллокатором
+    explicit SimpleVector(const Allocator& alloc) noexcept
+        : data_(alloc) {}
 
     // Конструктор с заданным размером
-    explicit SimpleVector(size_t size)
-        : size_(size), capacity_(size), data_(size == 0 ? nullptr : new Type[size]) {
-        std::fill_n(data_.Get(), size_, Type());
+    explicit SimpleVector(size_t size, const Allocator& alloc = Allocator())
+        : size_(size), data_(size, alloc) {
+        std::uninitialized_value_construct_n(data_.Get(), size_);
+        RecordAllocation(GrowthSite::kConstruct, 0);
     }
 
-    // Конструктор с резервированием ёмкости
-    explicit SimpleVector(ReserveProxyObj obj)
-        : capacity_(obj.GetCapacity()), data_(obj.GetCapacity() == 0 ? nullptr : new Type[obj.GetCapacity()]) {}
+    // Конструктор с резервированием ёмкости (элементы не создаются)
+    explicit SimpleVector(ReserveProxyObj obj, const Allocator& alloc = Allocator())
+        : data_(obj.GetCapacity(), alloc) {
+        RecordAllocation(GrowthSite::kConstruct, 0);
+    }
 
     // Конструктор с заданным размером и значением
-    SimpleVector(size_t size, const Type& value)
-        : size_(size), capacity_(size), data_(size == 0 ? nullptr : new Type[size]) {
-        std::fill_n(data_.Get(), size_, value);
+    SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+        : size_(size), data_(size, alloc) {
+        std::uninitialized_fill_n(data_.Get(), size_, value);
+        RecordAllocation(GrowthSite::kConstruct, 0);
     }
 
     // Конструктор с initializer_list
-    SimpleVector(std::initializer_list<Type> init)
-        : size_(init.size()), capacity_(init.size()), data_(init.size() == 0 ? nullptr : new Type[init.size()]) {
-        std::copy(init.begin(), init.end(), data_.Get());
+    SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+        : size_(init.size()), data_(init.size(), alloc) {
+        std::uninitialized_copy(init.begin(), init.end(), data_.Get());
+        RecordAllocation(GrowthSite::kConstruct, 0);
     }
 
-    // Деструктор (не нужен, так как ArrayPtr сам освобождает память)
-    ~SimpleVector() = default;
+    // Деструктор разрушает только живые элементы [0, size_), память освобождает ArrayPtr
+    ~SimpleVector() {
+        std::destroy_n(data_.Get(), size_);
+    }
 
     // Конструктор копирования
     SimpleVector(const SimpleVector& other)
-        : size_(other.size_), capacity_(other.size_), data_(other.size_ == 0 ? nullptr : new Type[other.size_]) {
-        std::copy(other.data_.Get(), other.data_.Get() + other.size_, data_.Get());
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator())) {}
+
+    // Копирование с заданным аллокатором
+    SimpleVector(const SimpleVector& other, const Allocator& alloc)
+        : size_(other.size_), data_(other.size_, alloc) {
+        std::uninitialized_copy_n(other.data_.Get(), other.size_, data_.Get());
+        RecordAllocation(GrowthSite::kConstruct, 0);
     }
 
     // Конструктор перемещения
     SimpleVector(SimpleVector&& other) noexcept
         : size_(std::exchange(other.size_, 0)),
-          capacity_(std::exchange(other.capacity_, 0)),
-          data_(std::move(other.data_)) {}
+          data_(std::move(other.data_)) {
+        stats_.OnSize(size_, GetCapacity());
+    }
 
     // Оператор присваивания
     SimpleVector& operator=(const SimpleVector& other) {
@@ -77,21 +117,45 @@ public:
             return *this; // Защита от самоприсваивания
         }
 
-        SimpleVector tmp(other); // Используем конструктор копирования
-        swap(tmp); // Обмениваем содержимое
+        // Копия сразу получает тот аллокатор, который должен остаться у *this
+        SimpleVector tmp(other, AllocTraits::propagate_on_container_copy_assignment::value
+                                    ? other.data_.GetAllocator()
+                                    : data_.GetAllocator());
+        SwapWithAllocator(tmp); // Обмениваем содержимое
+        RecordAllocation(GrowthSite::kAssign, tmp.GetCapacity());
         return *this;
     }
 
     // Оператор перемещающего присваивания
-    SimpleVector& operator=(SimpleVector&& other) noexcept {
-        if (this != &other) {
-            size_ = std::exchange(other.size_, 0);
-            capacity_ = std::exchange(other.capacity_, 0);
-            data_ = std::move(other.data_);
+    SimpleVector& operator=(SimpleVector&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (AllocTraits::propagate_on_container_move_assignment::value
+            || data_.GetAllocator() == other.data_.GetAllocator()) {
+            SimpleVector tmp(std::move(other)); // Старые элементы разрушит tmp
+            SwapWithAllocator(tmp);
+            stats_.OnSize(size_, GetCapacity());
+        }
+        else {
+            // Чужой буфер нельзя отдать своему аллокатору: переносим элементы поштучно
+            SimpleVector tmp(ReserveProxyObj(other.size_), data_.GetAllocator());
+            std::uninitialized_move_n(other.data_.Get(), other.size_, tmp.data_.Get());
+            tmp.size_ = other.size_;
+            other.Clear();
+            SwapWithAllocator(tmp);
+            RecordAllocation(GrowthSite::kAssign, tmp.GetCapacity());
         }
         return *this;
     }
 
+    // Аллокатор вектора
+    allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
     // Оператор индексирования
     Type& operator[](size_t index) noexcept {
         assert(index < size_ && "Index out of range");
@@ -118,32 +182,33 @@ public:
         return data_[index];
     }
 
-    // Изменение размера вектора
+    // Изменение размера вектора. Ёмкость растёт по GrowthPolicy, поэтому Resize(size + 1) амортизирован
     void Resize(size_t new_size) {
-        if (new_size == size_) {
-            return;
+        if (new_size > GetCapacity()) {
+            Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)), GrowthSite::kResize);
         }
 
-        if (new_size > capacity_) {
-            size_t new_capacity = new_size;
-            ArrayPtr<Type> new_data(new_capacity);
-
-            std::move(data_.Get(), data_.Get() + size_, new_data.Get());
-
-            for (size_t i = size_; i < new_size; ++i) {
-                new_data[i] = Type();
-            }
-
-            data_ = std::move(new_data);
-            capacity_ = new_capacity;
+        if (new_size > size_) {
+            std::uninitialized_value_construct(end(), begin() + new_size);
         }
         else {
-            for (size_t i = new_size; i < size_; ++i) {
-                data_[i] = Type();
-            }
+            std::destroy(begin() + new_size, end());
         }
 
         size_ = new_size;
+        stats_.OnSize(size_, GetCapacity());
+    }
+
+    // Resize без инициализации новых элементов: их значения не определены, пока не записаны.
+    // Для буферов, которые сразу целиком перезаписываются (декодеры, чтение из файла)
+    void ResizeUninitialized(size_t new_size) {
+        static_assert(std::is_trivially_default_constructible_v<Type> && std::is_trivially_destructible_v<Type>,
+                      "ResizeUninitialized requires a trivial type");
+        if (new_size > GetCapacity()) {
+            Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)), GrowthSite::kResize);
+        }
+        size_ = new_size;
+        stats_.OnSize(size_, GetCapacity());
     }
 
     // Итераторы
@@ -178,7 +243,7 @@ public:
 
     // Получение емкости
     size_t GetCapacity() const noexcept {
-        return capacity_;
+        return data_.GetSize();
     }
 
     // Проверка на пустоту
@@ -188,119 +253,50 @@ public:
 
     // Очистка вектора
     void Clear() noexcept {
+        std::destroy_n(data_.Get(), size_);
         size_ = 0;
     }
 
-     // Добавление элемента в конец
+    // Добавление элемента в конец
     void PushBack(const Type& item) {
-        if (size_ == capacity_) {
-            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-            Type* new_data = new Type[new_capacity];
-            std::copy(data_, data_ + size_, new_data);
-            delete[] data_;
-            data_ = new_data;
-            capacity_ = new_capacity;
-        }
-        data_[size_] = item;
-        ++size_;
+        EmplaceBack(item);
     }
 
     // Вставка элемента
     Iterator Insert(ConstIterator pos, const Type& value) {
-        if (pos < begin() || pos > end()) {
-            throw std::out_of_range("Insert position out of range");
-        }
-
-        // Вычисляем индекс для вставки
-        size_t insert_index = pos - begin();
-
-        // Если нужно увеличить ёмкость
-        if (size_ == capacity_) {
-            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-            Type* new_data = new Type[new_capacity];
-
-            // Копируем элементы до позиции вставки
-            std::copy(data_, data_ + insert_index, new_data);
-
-            // Вставляем новый элемент
-            new_data[insert_index] = value;
-
-            // Копируем оставшиеся элементы
-            std::copy(data_ + insert_index, data_ + size_, new_data + insert_index + 1);
-
-            // Освобождаем старую память
-            delete[] data_;
-            data_ = new_data;
-            capacity_ = new_capacity;
-        }
-        else {
-            // Сдвигаем элементы вправо
-            std::copy_backward(data_ + insert_index, data_ + size_, data_ + size_ + 1);
-
-            // Вставляем новый элемент
-            data_[insert_index] = value;
-        }
-
-        // Увеличиваем размер
-        ++size_;
-
-        // Возвращаем итератор на вставленный элемент
-        return begin() + insert_index;
+        return Emplace(pos, value);
     }
-    
+
     // Добавление элемента в конец
     void PushBack(Type&& item) {
-        if (size_ == capacity_) {
-            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-            ArrayPtr<Type> new_data(new_capacity);
-            std::move(begin(), end() + size_, new_data.Get());
-            data_ = std::move(new_data);
-            capacity_ = new_capacity;
-        }
-        data_[size_] = std::move(item);
-        ++size_;
+        EmplaceBack(std::move(item));
     }
 
     // Вставка элемента
     Iterator Insert(ConstIterator pos, Type&& value) {
-    if (pos < begin() || pos > end()) {
-        throw std::out_of_range("Insert position out of range");
+        return Emplace(pos, std::move(value));
     }
-    size_t insert_index = pos - begin();
 
-    if (size_ == capacity_) {
-        // Увеличиваем ёмкость
-        size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-        ArrayPtr<Type> new_data(new_capacity);
-
-        // Перемещаем элементы до позиции вставки
-        std::move(data_.Get(), data_.Get() + insert_index, new_data.Get());
-
-        // Вставляем новый элемент
-        new_data[insert_index] = std::move(value);
-
-        // Перемещаем оставшиеся элементы
-        std::move(data_.Get() + insert_index, data_.Get() + size_, new_data.Get() + insert_index + 1);
-
-        data_ = std::move(new_data);
-        capacity_ = new_capacity;
-    } else {
-        // Сдвигаем элементы вправо, начиная с позиции вставки
-        std::move_backward(data_.Get() + insert_index, data_.Get() + size_, data_.Get() + size_ + 1);
-
-        // Вставляем новый элемент
-        data_[insert_index] = std::move(value);
+    // Создание элемента в конце прямо из аргументов конструктора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAt(GrowthSite::kPushBack, size_, std::forward<Args>(args)...);
     }
 
-    ++size_;
-    return begin() + insert_index;
-}
+    // Создание элемента перед pos прямо из аргументов конструктора
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        if (pos < begin() || pos > end()) {
+            throw std::out_of_range("Insert position out of range");
+        }
+        return EmplaceAt(GrowthSite::kInsert, pos - cbegin(), std::forward<Args>(args)...);
+    }
 
     // Удаление последнего элемента
     void PopBack() noexcept {
         assert(size_ > 0 && "PopBack called on an empty container");
         --size_;
-        data_[size_] = Type(); // Очищаем последний элемент
+        std::destroy_at(data_.Get() + size_);
     }
 
     // Удаление элемента
@@ -312,69 +308,448 @@ public:
             throw std::out_of_range("Erase position out of range");
         }
 
-        Iterator non_const_pos = const_cast<Iterator>(pos);
-        std::move(non_const_pos + 1, end(), non_const_pos);
-        --size_;
-        data_[size_] = Type(); // Очищаем последний элемент
+        Iterator non_const_pos = begin() + (pos - cbegin());
+        ShiftLeft(non_const_pos, end() - non_const_pos - 1, 1);
+        PopBack(); // Разрушаем освободившийся последний элемент
+
+        return non_const_pos;
+    }
+
+    // Добавление диапазона в конец
+    template <typename InputIt>
+    void Append(InputIt first, InputIt last) {
+        InsertRange(cend(), first, last);
+    }
+
+    // Дописывает count элементов, которые construct(raw, count) создаёт прямо в свободной ёмкости.
+    // construct должен либо создать все count элементов, либо разрушить созданные и бросить исключение
+    template <typename Constructor>
+    void ConstructBack(size_t count, Constructor&& construct) {
+        if (size_ + count > GetCapacity()) {
+            Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), size_ + count, sizeof(Type)), GrowthSite::kPushBack);
+        }
+        construct(data_.Get() + size_, count);
+        size_ += count;
+        stats_.OnSize(size_, GetCapacity());
+    }
+
+    // Убирает последние count элементов, которые уже перенесены наружу через UninitializedRelocate:
+    // оболочки разрушаются через DestroyRelocated, побайтово перенесённые просто забываются.
+    // Обратная к ConstructBack операция для кода, забирающего элементы в свой буфер
+    void DestroyRelocatedBack(size_t count) noexcept {
+        assert(count <= size_);
+        DestroyRelocated(data_.Get() + size_ - count, count);
+        size_ -= count;
+    }
+
+    // Вставка диапазона перед pos. Диапазон не должен указывать внутрь вектора
+    template <typename InputIt>
+    Iterator InsertRange(ConstIterator pos, InputIt first, InputIt last) {
+        if (pos < begin() || pos > end()) {
+            throw std::out_of_range("Insert position out of range");
+        }
+        const size_t index = pos - cbegin();
+
+        if constexpr (kIsForwardIterator<InputIt>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count == 0) {
+                return begin() + index;
+            }
+            if (size_ + count > GetCapacity() && !TryGrowInPlace(size_ + count)) {
+                InsertRangeReallocating(index, first, last, count);
+            }
+            else {
+                InsertRangeInPlace(index, first, last, count);
+            }
+        }
+        else {
+            // Длина неизвестна: дописываем в конец и поворачиваем на место
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+        }
+        stats_.OnSize(size_, GetCapacity());
+        return begin() + index;
+    }
+
+    // Удаление диапазона [first, last) с единственным сдвигом хвоста
+    Iterator EraseRange(ConstIterator first, ConstIterator last) {
+        if (first < begin() || first > last || last > end()) {
+            throw std::out_of_range("Erase range out of range");
+        }
+
+        Iterator non_const_first = begin() + (first - cbegin());
+        const size_t count = last - first;
+        ShiftLeft(non_const_first, end() - non_const_first - count, count);
+        std::destroy(end() - count, end());
+        size_ -= count;
+
+        return non_const_first;
+    }
+
+    // Удаление элемента за O(1): на его место переносится последний элемент.
+    // Порядок элементов не сохраняется
+    Iterator SwapErase(ConstIterator pos) {
+        if (pos < begin() || pos >= end()) {
+            throw std::out_of_range("Erase position out of range");
+        }
+
+        Iterator non_const_pos = begin() + (pos - cbegin());
+        if (non_const_pos != end() - 1) {
+            *non_const_pos = std::move(*(end() - 1));
+        }
+        PopBack();
 
         return non_const_pos;
     }
 
-    // Обмен с другим вектором
+    // Удаляет элементы, для которых pred истинен, за один проход с сохранением порядка остальных.
+    // Освободившийся хвост разрушается один раз в конце. Возвращает число удалённых элементов
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred) {
+        return EraseTail(std::remove_if(begin(), end(), pred));
+    }
+
+    // Удаляет подряд идущие повторы, оставляя первый элемент каждой группы; в отсортированном
+    // векторе это удаляет все повторы. Возвращает число удалённых элементов
+    size_t RemoveDuplicates() {
+        return EraseTail(std::unique(begin(), end()));
+    }
+
+    template <typename BinaryPredicate>
+    size_t RemoveDuplicates(BinaryPredicate equal) {
+        return EraseTail(std::unique(begin(), end(), equal));
+    }
+
+    // Замена содержимого элементами диапазона
+    template <typename InputIt>
+    void Assign(InputIt first, InputIt last) {
+        if constexpr (kIsForwardIterator<InputIt>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count > GetCapacity()) {
+                SimpleVector tmp(ReserveProxyObj(count), data_.GetAllocator());
+                std::uninitialized_copy(first, last, tmp.data_.Get());
+                tmp.size_ = count;
+                SwapWithAllocator(tmp);
+                RecordAllocation(GrowthSite::kAssign, tmp.GetCapacity());
+            }
+            else if (count <= size_) {
+                Iterator new_end = std::copy(first, last, begin());
+                std::destroy(new_end, end());
+                size_ = count;
+            }
+            else {
+                InputIt mid = std::next(first, size_);
+                std::copy(first, mid, begin());
+                std::uninitialized_copy(mid, last, end());
+                size_ = count;
+            }
+            stats_.OnSize(size_, GetCapacity());
+        }
+        else {
+            Clear();
+            Append(first, last);
+        }
+    }
+
+    // Обмен с другим вектором. Без propagate_on_container_swap аллокаторы должны быть равны
     void swap(SimpleVector& other) noexcept {
-        std::swap(data_, other.data_);
-        std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
+        assert((AllocTraits::propagate_on_container_swap::value || GetAllocator() == other.GetAllocator())
+               && "Swapping vectors with unequal allocators");
+        SwapWithAllocator(other);
     }
 
     // Метод Reserve
     void Reserve(size_t new_capacity) {
-        if (new_capacity > capacity_) {
-            ArrayPtr<Type> new_data(new_capacity);
-            std::move(data_.Get(), data_.Get() + size_, new_data.Get());
-            data_ = std::move(new_data);
-            capacity_ = new_capacity;
+        if (new_capacity > GetCapacity()) {
+            Reallocate(new_capacity, GrowthSite::kReserve);
         }
     }
 
+    // Уменьшает ёмкость до размера. Возвращает число освобождённых байт
+    size_t ShrinkToFit() {
+        return TrimTo(size_);
+    }
+
+    // Уменьшает ёмкость до max(capacity, размер). Возвращает число освобождённых байт
+    size_t TrimTo(size_t capacity) {
+        const size_t new_capacity = std::max(capacity, size_);
+        const size_t old_capacity = GetCapacity();
+        if (Storage::UsableSize(data_.GetAllocator(), new_capacity) >= old_capacity) {
+            return 0;
+        }
+
+        if (new_capacity == 0) {
+            data_ = Storage(data_.GetAllocator());
+        }
+        else {
+            Reallocate(new_capacity, GrowthSite::kShrink);
+        }
+        return (old_capacity - GetCapacity()) * sizeof(Type);
+    }
+
+    // Удаляет все элементы и освобождает буфер. Возвращает число освобождённых байт
+    size_t ClearAndRelease() noexcept {
+        Clear();
+        const size_t freed = GetCapacity() * sizeof(Type);
+        data_ = Storage(data_.GetAllocator());
+        return freed;
+    }
+
+    // Поиск первого элемента, равного value; end(), если такого нет
+    Iterator Find(const Type& value) {
+        return begin() + RangeFind(data_.Get(), size_, value);
+    }
+
+    ConstIterator Find(const Type& value) const {
+        return begin() + RangeFind(data_.Get(), size_, value);
+    }
+
+    // Количество элементов, равных value
+    size_t Count(const Type& value) const {
+        return RangeCount(data_.Get(), size_, value);
+    }
+
+    bool Contains(const Type& value) const {
+        return Find(value) != end();
+    }
+
+    // Буфер выровнен на alignment байт; у пустого вектора без буфера — всегда
+    bool IsAligned(size_t alignment) const noexcept {
+        return IsAlignedPointer(data_.Get(), alignment);
+    }
+
+    // Указатель на данные с обещанием компилятору выравнивания на Alignment байт,
+    // например для буфера из AlignedAllocator. Выравнивание проверяет assert
+    template <size_t Alignment>
+    Type* AssumeAligned() noexcept {
+        return ::AssumeAligned<Alignment>(data_.Get());
+    }
+
+    template <size_t Alignment>
+    const Type* AssumeAligned() const noexcept {
+        return ::AssumeAligned<Alignment>(static_cast<const Type*>(data_.Get()));
+    }
+
+    // Снимок статистики; для NoVectorStats все счётчики нулевые
+    VectorStatsSnapshot GetStats() const noexcept {
+        return stats_.Snapshot();
+    }
+
 private:
     size_t size_ = 0;
-    size_t capacity_ = 0;
-    ArrayPtr<Type> data_;
+    Storage data_; // Ёмкость хранится в ArrayPtr
+    [[no_unique_address]] Stats stats_; // Принадлежит объекту и не переходит при обмене буферами
+
+    // Учитывает появление текущего буфера взамен буфера ёмкостью old_capacity
+    void RecordAllocation(GrowthSite site, size_t old_capacity) noexcept {
+        if (GetCapacity() != 0) {
+            stats_.OnAllocate(site, old_capacity != 0);
+        }
+        stats_.OnSize(size_, GetCapacity());
+    }
+
+    // Разрушает элементы [new_end, end()) после уплотнения
+    size_t EraseTail(Iterator new_end) noexcept {
+        const size_t erased = end() - new_end;
+        std::destroy(new_end, end());
+        size_ -= erased;
+        return erased;
+    }
+
+    // Буфер всегда уходит вместе со своим аллокатором
+    void SwapWithAllocator(SimpleVector& other) noexcept {
+        data_.swap(other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    // Растит буфер на месте до ёмкости по политике роста для required элементов,
+    // если аллокатор умеет расширять выделение. Элементы и ссылки на них не двигаются
+    bool TryGrowInPlace(size_t required) noexcept {
+        if (!data_.TryExtend(GrowthPolicy::NextCapacity(GetCapacity(), required, sizeof(Type)))) {
+            return false;
+        }
+        stats_.OnSize(size_, GetCapacity());
+        return true;
+    }
+
+    // Переносит живые элементы в новый буфер ёмкостью new_capacity
+    void Reallocate(size_t new_capacity, GrowthSite site) {
+        if (new_capacity > GetCapacity() && data_.TryExtend(new_capacity)) {
+            stats_.OnSize(size_, GetCapacity());
+            return;
+        }
+        const size_t old_capacity = GetCapacity();
+        if constexpr (kReallocateBitwise) {
+            if (data_.TryReallocate(new_capacity)) {
+                RecordAllocation(site, old_capacity);
+                return;
+            }
+        }
+        Storage new_data(new_capacity, data_.GetAllocator());
+        UninitializedRelocate(data_.Get(), size_, new_data.Get());
+        DestroyRelocated(data_.Get(), size_);
+        data_.swap(new_data);
+        stats_.template OnRelocate<Type>(size_);
+        RecordAllocation(site, old_capacity);
+    }
+
+    // Вставляет count элементов [first, last) на позицию index в новый буфер
+    template <typename ForwardIt>
+    void InsertRangeReallocating(size_t index, ForwardIt first, ForwardIt last, size_t count) {
+        const size_t old_capacity = GetCapacity();
+        const size_t new_capacity = GrowthPolicy::NextCapacity(old_capacity, size_ + count, sizeof(Type));
+        Storage new_data(new_capacity, data_.GetAllocator());
+        Type* slot = new_data.Get() + index;
+
+        std::uninitialized_copy(first, last, slot);
+        try {
+            UninitializedRelocate(data_.Get(), index, new_data.Get());
+        }
+        catch (...) {
+            std::destroy_n(slot, count);
+            throw;
+        }
+        try {
+            UninitializedRelocate(data_.Get() + index, size_ - index, slot + count);
+        }
+        catch (...) {
+            std::destroy(new_data.Get(), slot + count);
+            throw;
+        }
+
+        DestroyRelocated(data_.Get(), size_);
+        data_.swap(new_data);
+        stats_.template OnRelocate<Type>(size_);
+        size_ += count;
+        RecordAllocation(GrowthSite::kInsert, old_capacity);
+    }
+
+    // Вставляет count элементов [first, last) на позицию index без перевыделения.
+    // Хвост сдвигается один раз; size_ отслеживает уже созданные элементы
+    template <typename ForwardIt>
+    void InsertRangeInPlace(size_t index, ForwardIt first, ForwardIt last, size_t count) {
+        Type* pos = data_.Get() + index;
+        Type* old_end = end();
+        const size_t tail = size_ - index;
+
+        if constexpr (kRelocateBitwise<Type>) {
+            std::memmove(static_cast<void*>(pos + count), static_cast<const void*>(pos), tail * sizeof(Type));
+            try {
+                std::uninitialized_copy(first, last, pos);
+            }
+            catch (...) {
+                std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos + count), tail * sizeof(Type));
+                throw;
+            }
+            size_ += count;
+        }
+        else if (tail > count) {
+            std::uninitialized_move(old_end - count, old_end, old_end);
+            size_ += count;
+            std::move_backward(pos, old_end - count, old_end);
+            std::copy(first, last, pos);
+        }
+        else {
+            ForwardIt mid = std::next(first, tail);
+            std::uninitialized_copy(mid, last, old_end);
+            size_ += count - tail;
+            std::uninitialized_move(pos, old_end, pos + count);
+            size_ += tail;
+            std::copy(first, mid, pos);
+        }
+    }
+
+    // Создаёт элемент из args на позиции index, сдвигая хвост вправо
+    template <typename... Args>
+    Iterator EmplaceAt(GrowthSite site, size_t index, Args&&... args) {
+        assert(index <= size_);
+
+        if constexpr (kReallocateBitwise) {
+            if (size_ == GetCapacity() && !TryGrowInPlace(size_ + 1)) {
+                // Буфер может переехать вместе с элементами, на которые ссылаются args
+                Type tmp(std::forward<Args>(args)...);
+                Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), size_ + 1, sizeof(Type)), site);
+                return EmplaceAt(site, index, std::move(tmp));
+            }
+        }
+
+        if (size_ == GetCapacity() && !TryGrowInPlace(size_ + 1)) {
+            const size_t old_capacity = GetCapacity();
+            const size_t new_capacity = GrowthPolicy::NextCapacity(old_capacity, size_ + 1, sizeof(Type));
+            Storage new_data(new_capacity, data_.GetAllocator());
+            Type* slot = new_data.Get() + index;
+
+            // Новый элемент создаётся первым: args могут ссылаться на элементы старого буфера
+            ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+            try {
+                UninitializedRelocate(data_.Get(), index, new_data.Get());
+            }
+            catch (...) {
+                std::destroy_at(slot);
+                throw;
+            }
+            try {
+                UninitializedRelocate(data_.Get() + index, size_ - index, slot + 1);
+            }
+            catch (...) {
+                std::destroy(new_data.Get(), slot + 1);
+                throw;
+            }
+
+            DestroyRelocated(data_.Get(), size_);
+            data_.swap(new_data);
+            stats_.template OnRelocate<Type>(size_);
+            ++size_;
+            RecordAllocation(site, old_capacity);
+        }
+        else if (index == size_) {
+            ::new (static_cast<void*>(end())) Type(std::forward<Args>(args)...);
+            ++size_;
+        }
+        else {
+            // Элемент собирается до сдвига: args могут ссылаться на сдвигаемые элементы
+            Type tmp(std::forward<Args>(args)...);
+            ShiftRightByOne(begin() + index, size_ - index);
+            ++size_;
+            data_[index] = std::move(tmp);
+        }
+        stats_.OnSize(size_, GetCapacity());
+        return begin() + index;
+    }
 };
 
 // Операторы сравнения
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(
-        lhs.begin(), lhs.end(), // Начало и конец первого диапазона
-        rhs.begin(), rhs.end()  // Начало и конец второго диапазона
-    );
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+inline bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& rhs) {
+    return RangeLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize()); // Векторное ядро для арифметических типов
 }
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+inline bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& rhs) {
     return lhs.GetSize() == rhs.GetSize() &&
-        std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        RangeEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+inline bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+inline bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& rhs) {
     return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+inline bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& rhs) {
     return !(lhs > rhs);
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+inline bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& lhs, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& rhs) {
     return !(lhs < rhs);
 }
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "simple_vector.h"
+
+// Монотонная арена для короткоживущих векторов, например векторов одного запроса.
+// Память выдаётся сдвигом указателя внутри блоков, освобождение отдельных буферов
+// ничего не стоит, а Reset разом возвращает всё. Последнее выделение можно расширить
+// на месте, поэтому растущий вектор, выделявший память последним, не переносит элементы.
+// Reset можно вызывать только после разрушения всех векторов, живущих в арене
+class SimpleVectorArena {
+    struct Block {
+        unsigned char* data;
+        size_t size;
+    };
+
+public:
+    explicit SimpleVectorArena(size_t block_bytes = size_t{64} << 10) noexcept
+        : next_block_bytes_(std::max(block_bytes, sizeof(std::max_align_t))) {}
+
+    ~SimpleVectorArena() {
+        for (const Block& block : blocks_) {
+            ::operator delete(block.data);
+        }
+    }
+
+    SimpleVectorArena(const SimpleVectorArena&) = delete;
+    SimpleVectorArena& operator=(const SimpleVectorArena&) = delete;
+
+    // Выделяет bytes байт с выравниванием alignment (степень двойки)
+    void* Allocate(size_t bytes, size_t alignment) {
+        unsigned char* result = AlignUp(top_, alignment);
+        if (result == nullptr || result > limit_ || bytes > static_cast<size_t>(limit_ - result)) {
+            AddBlock(bytes + alignment);
+            result = AlignUp(top_, alignment);
+        }
+        top_ = result + bytes;
+        allocated_ += bytes;
+        return result;
+    }
+
+    // Увеличивает блок ptr с old_bytes до new_bytes, если он выделен последним и в блоке есть место
+    bool TryExtend(void* ptr, size_t old_bytes, size_t new_bytes) noexcept {
+        unsigned char* begin = static_cast<unsigned char*>(ptr);
+        if (begin + old_bytes != top_ || new_bytes > static_cast<size_t>(limit_ - begin)) {
+            return false;
+        }
+        top_ = begin + new_bytes;
+        allocated_ += new_bytes - old_bytes;
+        return true;
+    }
+
+    // Освобождение отдельного буфера бесплатно; последний выделенный буфер возвращается в арену
+    void Deallocate(void* ptr, size_t bytes) noexcept {
+        unsigned char* begin = static_cast<unsigned char*>(ptr);
+        if (begin + bytes == top_) {
+            top_ = begin;
+        }
+    }
+
+    // Освобождает всё выделенное. Самый большой блок остаётся для следующего раунда
+    void Reset() noexcept {
+        if (!blocks_.IsEmpty()) {
+            Block* largest = std::max_element(blocks_.begin(), blocks_.end(), [](const Block& lhs, const Block& rhs) {
+                return lhs.size < rhs.size;
+            });
+            std::swap(*largest, blocks_[0]);
+            for (size_t i = 1; i < blocks_.GetSize(); ++i) {
+                ::operator delete(blocks_[i].data);
+            }
+            blocks_.Resize(1);
+            top_ = blocks_[0].data;
+            limit_ = top_ + blocks_[0].size;
+        }
+        allocated_ = 0;
+    }
+
+    // Байт выдано с последнего Reset, включая уже освобождённые буферы
+    size_t GetBytesAllocated() const noexcept {
+        return allocated_;
+    }
+
+    size_t GetBlockCount() const noexcept {
+        return blocks_.GetSize();
+    }
+
+private:
+    SimpleVector<Block> blocks_;
+    unsigned char* top_ = nullptr;
+    unsigned char* limit_ = nullptr;
+    size_t next_block_bytes_;
+    size_t allocated_ = 0;
+
+    static unsigned char* AlignUp(unsigned char* ptr, size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + ((alignment - address % alignment) % alignment);
+    }
+
+    // Новый блок не меньше min_bytes; размеры блоков растут вдвое
+    void AddBlock(size_t min_bytes) {
+        const size_t size = std::max(next_block_bytes_, min_bytes);
+        blocks_.Reserve(blocks_.GetSize() + 1);
+        unsigned char* data = static_cast<unsigned char*>(::operator new(size));
+        blocks_.PushBack({data, size});
+        top_ = data;
+        limit_ = data + size;
+        next_block_bytes_ = size > std::numeric_limits<size_t>::max() / 2 ? size : size * 2;
+    }
+};
+
+// Аллокатор SimpleVector поверх SimpleVectorArena. deallocate почти ничего не делает,
+// а TryExtend позволяет SimpleVector расти на месте.
+// Буфер переезжает вместе с аллокатором при перемещении и обмене векторов
+template <typename Type>
+class ArenaAllocator {
+public:
+    using value_type = Type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit ArenaAllocator(SimpleVectorArena& arena) noexcept
+        : arena_(&arena) {}
+
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other>& other) noexcept
+        : arena_(other.GetArena()) {}
+
+    Type* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<Type*>(arena_->Allocate(n * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t n) noexcept {
+        arena_->Deallocate(ptr, n * sizeof(Type));
+    }
+
+    bool TryExtend(Type* ptr, size_t n, size_t new_n) noexcept {
+        return new_n <= std::numeric_limits<size_t>::max() / sizeof(Type)
+            && arena_->TryExtend(ptr, n * sizeof(Type), new_n * sizeof(Type));
+    }
+
+    SimpleVectorArena* GetArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    SimpleVectorArena* arena_;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// Вектор, живущий в арене
+template <typename Type, typename GrowthPolicy = DoublingGrowth>
+using ArenaSimpleVector = SimpleVector<Type, ArenaAllocator<Type>, GrowthPolicy>;
@@ -0,0 +1,434 @@
+#include "simple_vector.h"
+#include "realloc_allocator.h"
+#include "segmented_simple_vector.h"
+#include "simple_flat_map.h"
+#include "simple_ring_vector.h"
+#include "simple_vector_arena.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// 64-байтная POD-запись
+struct Pod64 {
+    uint64_t fields[8];
+};
+
+bool operator==(const Pod64& lhs, const Pod64& rhs) {
+    return equal(begin(lhs.fields), end(lhs.fields), begin(rhs.fields));
+}
+
+bool operator<(const Pod64& lhs, const Pod64& rhs) {
+    return lexicographical_compare(begin(lhs.fields), end(lhs.fields), begin(rhs.fields), end(rhs.fields));
+}
+
+// Некопируемый тип, как X из main.cpp
+class X {
+public:
+    X()
+        : X(5) {
+    }
+    X(size_t num)
+        : x_(num) {
+    }
+    X(const X& other) = delete;
+    X& operator=(const X& other) = delete;
+    X(X&& other) {
+        x_ = exchange(other.x_, 0);
+    }
+    X& operator=(X&& other) {
+        x_ = exchange(other.x_, 0);
+        return *this;
+    }
+    size_t GetX() const {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
+
+template <typename T>
+T MakeValue(size_t i) {
+    if constexpr (is_same_v<T, string>) {
+        return "benchmark-value-"s + to_string(i); // Длиннее SSO-буфера
+    }
+    else if constexpr (is_same_v<T, Pod64>) {
+        Pod64 pod{};
+        pod.fields[0] = i;
+        return pod;
+    }
+    else {
+        return T(i);
+    }
+}
+
+// Единый интерфейс к SimpleVector и std::vector
+
+template <typename T, typename Allocator>
+void Append(SimpleVector<T, Allocator>& v, T&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename T>
+void Append(vector<T>& v, T&& value) {
+    v.push_back(std::move(value));
+}
+
+template <typename T, size_t SegmentSize>
+void Append(SegmentedSimpleVector<T, SegmentSize>& v, T&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename T>
+void InsertAt(SimpleVector<T>& v, size_t index, T&& value) {
+    v.Insert(v.begin() + index, std::move(value));
+}
+
+template <typename T>
+void InsertAt(vector<T>& v, size_t index, T&& value) {
+    v.insert(v.begin() + index, std::move(value));
+}
+
+template <typename T>
+void EraseAt(SimpleVector<T>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename T>
+void EraseAt(vector<T>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename T>
+void ReserveFor(SimpleVector<T>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename T>
+void ReserveFor(vector<T>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename T>
+void ResizeTo(SimpleVector<T>& v, size_t size) {
+    v.Resize(size);
+}
+
+template <typename T>
+void ResizeTo(vector<T>& v, size_t size) {
+    v.resize(size);
+}
+
+template <typename T>
+auto FindValue(const SimpleVector<T>& v, const T& value) {
+    return v.Find(value);
+}
+
+template <typename T>
+auto FindValue(const vector<T>& v, const T& value) {
+    return find(v.begin(), v.end(), value);
+}
+
+template <typename Container>
+using ValueOf = remove_reference_t<decltype(*declval<Container&>().begin())>;
+
+template <typename Container>
+Container MakeContainer(size_t size) {
+    Container v;
+    ReserveFor(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        Append(v, MakeValue<ValueOf<Container>>(i));
+    }
+    return v;
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            Append(v, MakeValue<ValueOf<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_PushBackReserved(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Container v;
+        ReserveFor(v, size);
+        for (size_t i = 0; i < size; ++i) {
+            Append(v, MakeValue<ValueOf<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Вставка size элементов; position задаёт точку вставки: 0 — начало, 1 — середина, 2 — конец
+template <typename Container, int position>
+void BM_Insert(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            const size_t index = position == 0 ? 0 : position == 1 ? i / 2 : i;
+            InsertAt(v, index, MakeValue<ValueOf<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_EraseMiddle(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container v = MakeContainer<Container>(size);
+        state.ResumeTiming();
+        for (size_t i = size; i > 0; --i) {
+            EraseAt(v, i / 2);
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_ResizeIncremental(benchmark::State& state) {
+    const size_t size = state.range(0);
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 1; i <= size; ++i) {
+            ResizeTo(v, i);
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_CopyConstruct(benchmark::State& state) {
+    const Container source = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_MoveConstruct(benchmark::State& state) {
+    Container source = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        Container moved(std::move(source));
+        benchmark::DoNotOptimize(moved.begin());
+        source = std::move(moved);
+    }
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    Container v = MakeContainer<Container>(state.range(0));
+    for (auto _ : state) {
+        for (auto& item : v) {
+            benchmark::DoNotOptimize(&item);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Container>
+void BM_Compare(benchmark::State& state) {
+    const Container lhs = MakeContainer<Container>(state.range(0));
+    const Container rhs(lhs);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Поиск отсутствующего значения: проход по всему диапазону
+template <typename Container>
+void BM_Find(benchmark::State& state) {
+    const Container v = MakeContainer<Container>(state.range(0));
+    const auto missing = MakeValue<ValueOf<Container>>(state.range(0) + 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FindValue(v, missing));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Пакет запросов: каждый создаёт range(0) векторов по 32 элемента и разрушает их в конце.
+// С ареной буферы выделяются сдвигом указателя, а арена сбрасывается после запроса
+constexpr int kRequestsPerBatch = 1000;
+
+void BM_RequestBatchDefault(benchmark::State& state) {
+    const int vectors = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        for (int request = 0; request < kRequestsPerBatch; ++request) {
+            SimpleVector<SimpleVector<int>> scratch(Reserve(vectors));
+            for (int i = 0; i < vectors; ++i) {
+                scratch.EmplaceBack();
+                for (int j = 0; j < 32; ++j) {
+                    scratch[i].PushBack(j);
+                }
+            }
+            benchmark::DoNotOptimize(scratch.begin());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kRequestsPerBatch);
+}
+
+void BM_RequestBatchArena(benchmark::State& state) {
+    const int vectors = static_cast<int>(state.range(0));
+    SimpleVectorArena arena;
+    for (auto _ : state) {
+        for (int request = 0; request < kRequestsPerBatch; ++request) {
+            {
+                const ArenaAllocator<int> alloc(arena);
+                SimpleVector<ArenaSimpleVector<int>, ArenaAllocator<ArenaSimpleVector<int>>> scratch(
+                    Reserve(vectors), ArenaAllocator<ArenaSimpleVector<int>>(arena));
+                for (int i = 0; i < vectors; ++i) {
+                    scratch.EmplaceBack(alloc);
+                    for (int j = 0; j < 32; ++j) {
+                        scratch[i].PushBack(j);
+                    }
+                }
+                benchmark::DoNotOptimize(scratch.begin());
+            }
+            arena.Reset();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kRequestsPerBatch);
+}
+
+bool HasKey(const SimpleFlatMap<int, int>& table, int key) {
+    return table.Contains(key);
+}
+
+bool HasKey(const map<int, int>& table, int key) {
+    return table.find(key) != table.end();
+}
+
+// Поиск случайных ключей в таблице из range(0) пар; половины ключей в таблице нет
+template <typename Map>
+void BM_MapFind(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Map table;
+    for (int i = 0; i < size; ++i) {
+        table[i * 2] = i;
+    }
+    SimpleVector<int> keys(1024);
+    uint32_t seed = 1;
+    for (int& key : keys) {
+        seed = seed * 1664525u + 1013904223u;
+        key = static_cast<int>(seed % static_cast<uint32_t>(size * 2));
+    }
+    for (auto _ : state) {
+        int found = 0;
+        for (int key : keys) {
+            found += HasKey(table, key);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.GetSize());
+}
+
+// Очередь из range(0) элементов: каждый шаг добавляет элемент в конец и снимает с начала
+template <typename Queue>
+void BM_QueueFront(benchmark::State& state) {
+    const int size = static_cast<int>(state.range(0));
+    Queue queue;
+    for (int i = 0; i < size; ++i) {
+        queue.PushBack(i);
+    }
+    int next = size;
+    for (auto _ : state) {
+        queue.PushBack(next++);
+        if constexpr (is_same_v<Queue, SimpleRingVector<int>>) {
+            queue.PopFront();
+        }
+        else {
+            queue.Erase(queue.begin());
+        }
+        benchmark::DoNotOptimize(queue[0]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+constexpr int64_t kLarge = 1 << 16;
+constexpr int64_t kShifting = 1 << 11; // Вставки и удаления квадратичны, размеры меньше
+
+}  // namespace
+
+// Каждый бенчмарк регистрируется парой SimpleVector / std::vector, чтобы результаты шли рядом
+#define SV_BENCH_PAIR(bm, type, lo, hi)                                                \
+    BENCHMARK_TEMPLATE(bm, SimpleVector<type>)->RangeMultiplier(8)->Range(lo, hi);     \
+    BENCHMARK_TEMPLATE(bm, vector<type>)->RangeMultiplier(8)->Range(lo, hi)
+
+#define SV_BENCH_INSERT_PAIR(type, position)                                                    \
+    BENCHMARK_TEMPLATE(BM_Insert, SimpleVector<type>, position)->Range(kShifting, kShifting);  \
+    BENCHMARK_TEMPLATE(BM_Insert, vector<type>, position)->Range(kShifting, kShifting)
+
+#define SV_BENCH_MOVABLE(type)                             \
+    SV_BENCH_PAIR(BM_PushBack, type, 8, kLarge);           \
+    SV_BENCH_PAIR(BM_PushBackReserved, type, 8, kLarge);   \
+    SV_BENCH_INSERT_PAIR(type, 0);                         \
+    SV_BENCH_INSERT_PAIR(type, 1);                         \
+    SV_BENCH_INSERT_PAIR(type, 2);                         \
+    SV_BENCH_PAIR(BM_EraseMiddle, type, kShifting, kShifting); \
+    SV_BENCH_PAIR(BM_ResizeIncremental, type, 8, kLarge);  \
+    SV_BENCH_PAIR(BM_MoveConstruct, type, kLarge, kLarge); \
+    SV_BENCH_PAIR(BM_Iterate, type, 8, kLarge)
+
+#define SV_BENCH_COPYABLE(type)                            \
+    SV_BENCH_MOVABLE(type);                                \
+    SV_BENCH_PAIR(BM_CopyConstruct, type, 8, kLarge);      \
+    SV_BENCH_PAIR(BM_Compare, type, 8, kLarge);           \
+    SV_BENCH_PAIR(BM_Find, type, 8, kLarge)
+
+SV_BENCH_COPYABLE(int);
+SV_BENCH_COPYABLE(string);
+SV_BENCH_COPYABLE(Pod64);
+SV_BENCH_MOVABLE(X);
+
+BENCHMARK(BM_RequestBatchDefault)->Arg(8)->Arg(32);
+BENCHMARK(BM_RequestBatchArena)->Arg(8)->Arg(32);
+
+// Сегментированный вектор растёт без переноса элементов
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedSimpleVector<int>)->RangeMultiplier(8)->Range(8, kLarge);
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedSimpleVector<string>)->RangeMultiplier(8)->Range(8, kLarge);
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedSimpleVector<Pod64>)->RangeMultiplier(8)->Range(8, kLarge);
+
+// Рост через realloc без поэлементного переноса
+BENCHMARK_TEMPLATE(BM_PushBack, ReallocSimpleVector<int>)->RangeMultiplier(8)->Range(8, kLarge);
+BENCHMARK_TEMPLATE(BM_PushBack, ReallocSimpleVector<Pod64>)->RangeMultiplier(8)->Range(8, kLarge);
+
+// Плоская таблица против std::map
+BENCHMARK_TEMPLATE(BM_MapFind, SimpleFlatMap<int, int>)->RangeMultiplier(16)->Range(16, kLarge);
+BENCHMARK_TEMPLATE(BM_MapFind, map<int, int>)->RangeMultiplier(16)->Range(16, kLarge);
+
+// Снятие с начала: кольцевой вектор против сдвига SimpleVector
+BENCHMARK_TEMPLATE(BM_QueueFront, SimpleRingVector<int>)->RangeMultiplier(16)->Range(16, kLarge);
+BENCHMARK_TEMPLATE(BM_QueueFront, SimpleVector<int>)->RangeMultiplier(16)->Range(16, kLarge);
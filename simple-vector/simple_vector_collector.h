@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "parallel_algorithms.h"
+#include "relocate.h"
+#include "simple_vector.h"
+
+// Сбор результатов из многих потоков без общей точки синхронизации на каждое добавление.
+// Каждый поток получает собственный SimpleVector-шард и пишет в него как в обычный вектор.
+// Collect один раз резервирует итоговый вектор под сумму размеров шардов и параллельно
+// переносит шарды на их места (для тривиальных типов — побайтово).
+// Local, PushBack и EmplaceBack можно вызывать одновременно из разных потоков;
+// Collect, CollectInto и GetSize требуют, чтобы производители закончили работу.
+template <typename Type>
+class SimpleVectorCollector {
+public:
+    using Shard = SimpleVector<Type>;
+
+    SimpleVectorCollector() = default;
+
+    SimpleVectorCollector(const SimpleVectorCollector&) = delete;
+    SimpleVectorCollector& operator=(const SimpleVectorCollector&) = delete;
+
+    // Шард вызывающего потока. Ссылка верна до разрушения сборщика
+    Shard& Local() {
+        if (cache_.owner == id_) {
+            return *cache_.shard;
+        }
+
+        const std::thread::id thread = std::this_thread::get_id();
+        std::lock_guard lock(mutex_);
+        Slot* slot = std::find_if(shards_.begin(), shards_.end(), [thread](const Slot& candidate) {
+            return candidate->thread == thread;
+        });
+        if (slot == shards_.end()) {
+            shards_.PushBack(std::make_unique<PaddedShard>(thread));
+            slot = shards_.end() - 1;
+        }
+        cache_ = {id_, &(*slot)->shard};
+        return (*slot)->shard;
+    }
+
+    // Добавление элемента в шард вызывающего потока
+    void PushBack(const Type& item) {
+        Local().PushBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        Local().PushBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Local().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Суммарное число элементов во всех шардах
+    size_t GetSize() const {
+        std::lock_guard lock(mutex_);
+        size_t total = 0;
+        for (const Slot& slot : shards_) {
+            total += slot->shard.GetSize();
+        }
+        return total;
+    }
+
+    // Число потоков, получивших шард
+    size_t GetShardCount() const {
+        std::lock_guard lock(mutex_);
+        return shards_.GetSize();
+    }
+
+    // Переносит все шарды в конец dest одним резервированием. Порядок элементов внутри
+    // шарда сохраняется, шарды идут в порядке первого обращения потоков. Шарды остаются
+    // пустыми, но сохраняют ёмкость для следующего раунда
+    template <typename Allocator, typename GrowthPolicy, typename Stats>
+    void CollectInto(SimpleVector<Type, Allocator, GrowthPolicy, Stats>& dest, const ParallelOptions& options = {}) {
+        std::lock_guard lock(mutex_);
+        const size_t shard_count = shards_.GetSize();
+
+        // offsets[i] — позиция начала шарда i в переносимом диапазоне
+        SimpleVector<size_t> offsets(Reserve(shard_count + 1));
+        offsets.PushBack(0);
+        for (const Slot& slot : shards_) {
+            offsets.PushBack(offsets[offsets.GetSize() - 1] + slot->shard.GetSize());
+        }
+        const size_t total = offsets[shard_count];
+
+        dest.Reserve(dest.GetSize() + total);
+        dest.ConstructBack(total, [&](Type* raw, size_t count) {
+            ParallelConstruct(raw, count, options, [&](size_t first, size_t last) {
+                RelocateRange(offsets, raw, first, last);
+            });
+        });
+
+        for (const Slot& slot : shards_) {
+            // Элементы уже живут в dest: Clear разрушил бы побайтово перенесённые второй раз
+            slot->shard.DestroyRelocatedBack(slot->shard.GetSize());
+        }
+    }
+
+    SimpleVector<Type> Collect(const ParallelOptions& options = {}) {
+        SimpleVector<Type> result;
+        CollectInto(result, options);
+        return result;
+    }
+
+private:
+    // Шард на своих кэш-линиях, чтобы размер одного не делил линию с соседним
+    struct alignas(kCacheLineSize) PaddedShard {
+        explicit PaddedShard(std::thread::id owner) : thread(owner) {}
+
+        Shard shard;
+        std::thread::id thread;
+    };
+
+    using Slot = std::unique_ptr<PaddedShard>;
+
+    // Последний сборщик, к которому обращался поток, и его шард
+    struct Cache {
+        std::uint64_t owner = 0;
+        Shard* shard = nullptr;
+    };
+
+    static inline std::atomic<std::uint64_t> next_id_ = 1;
+    static inline thread_local Cache cache_;
+
+    const std::uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed); // Не переиспользуется, в отличие от адреса
+    mutable std::mutex mutex_;
+    SimpleVector<Slot> shards_;
+
+    // Переносит элементы с позиций [first, last) общего диапазона в raw + first.
+    // При исключении разрушает созданное им самим
+    void RelocateRange(const SimpleVector<size_t>& offsets, Type* raw, size_t first, size_t last) {
+        size_t shard = std::upper_bound(offsets.begin(), offsets.end(), first) - offsets.begin() - 1;
+        size_t done = first;
+        try {
+            while (done < last) {
+                const size_t shard_end = std::min(last, offsets[shard + 1]);
+                Type* src = shards_[shard]->shard.begin() + (done - offsets[shard]);
+                UninitializedRelocate(src, shard_end - done, raw + done);
+                done = shard_end;
+                ++shard;
+            }
+        }
+        catch (...) {
+            DiscardRelocated(raw + first, done - first);
+            throw;
+        }
+    }
+};
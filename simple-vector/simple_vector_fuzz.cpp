@@ -0,0 +1,375 @@
+// Дифференциальный тест: случайные последовательности операций выполняются над SimpleVector
+// (и его вариантами) и над std::vector, после каждой операции содержимое сравнивается.
+// Собирается с ASan/UBSan (см. CMakeLists.txt), поэтому выход за буфер, двойное разрушение
+// и утечки ловятся, даже если содержимое совпало.
+//
+// Запуск: simple_vector_fuzz [число прогонов] [seed]. С -DSIMPLE_VECTOR_LIBFUZZER вместо main
+// определяется LLVMFuzzerTestOneInput, и те же операции берутся из входа libFuzzer
+#include "realloc_allocator.h"
+#include "simple_vector.h"
+#include "small_simple_vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Байты входа как источник решений; по исчерпании — нули
+class Input {
+public:
+    Input(const uint8_t* data, size_t size)
+        : data_(data), size_(size) {}
+
+    bool IsEmpty() const {
+        return pos_ >= size_;
+    }
+
+    uint8_t Byte() {
+        return pos_ < size_ ? data_[pos_++] : 0;
+    }
+
+    // Число из [0, bound]
+    size_t Upto(size_t bound) {
+        const size_t value = Byte() | (size_t{Byte()} << 8);
+        return value % (bound + 1);
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+[[noreturn]] void Fail(const char* vector, size_t step, const char* op, const char* what) {
+    fprintf(stderr, "%s: step %zu, %s: %s\n", vector, step, op, what);
+    abort();
+}
+
+template <typename T>
+T MakeValue(size_t seed) {
+    if constexpr (is_same_v<T, string>) {
+        return "fuzz-value-longer-than-sso-"s + to_string(seed); // Строки с кучей ловят двойное разрушение
+    }
+    else {
+        return static_cast<T>(seed);
+    }
+}
+
+// Операции, которые есть у всех проверяемых векторов
+enum Op : uint8_t {
+    kPushBackCopy,
+    kPushBackMove,
+    kPushBackSelf,
+    kEmplaceBack,
+    kInsertCopy,
+    kInsertSelf,
+    kEmplace,
+    kErase,
+    kPopBack,
+    kResize,
+    kReserve,
+    kClear,
+    kCopyAssign,
+    kMoveAssign,
+    kSwap,
+    kBasicOpCount,
+    // Только SimpleVector
+    kAppend = kBasicOpCount,
+    kInsertRange,
+    kEraseRange,
+    kAssign,
+    kShrinkToFit,
+    kSwapErase,
+    kEraseIf,
+    kRemoveDuplicates,
+    kFullOpCount,
+};
+
+const char* kOpNames[] = {
+    "PushBack(const&)", "PushBack(&&)", "PushBack(self)", "EmplaceBack", "Insert(const&)", "Insert(self)",
+    "Emplace", "Erase", "PopBack", "Resize", "Reserve", "Clear", "copy assign", "move assign", "swap",
+    "Append", "InsertRange", "EraseRange", "Assign", "ShrinkToFit", "SwapErase", "EraseIf", "RemoveDuplicates",
+};
+
+template <typename Vector, bool FullApi>
+class Differential {
+    using Value = remove_reference_t<decltype(declval<Vector&>()[0])>;
+
+public:
+    explicit Differential(const char* name)
+        : name_(name) {}
+
+    void Run(Input& input) {
+        for (step_ = 0; !input.IsEmpty() && step_ < kMaxSteps; ++step_) {
+            const Op op = static_cast<Op>(input.Byte() % (FullApi ? kFullOpCount : kBasicOpCount));
+            Apply(op, input);
+            Check(kOpNames[op]);
+        }
+    }
+
+private:
+    static constexpr size_t kMaxSteps = 4096;
+    static constexpr size_t kMaxSize = 300;
+
+    const char* name_;
+    Vector v_;
+    vector<Value> expected_;
+    size_t seed_ = 0;
+    size_t step_ = 0;
+
+    Value Next() {
+        return MakeValue<Value>(seed_++);
+    }
+
+    void Apply(Op op, Input& input) {
+        const size_t size = expected_.size();
+        switch (op) {
+            case kPushBackCopy: {
+                const Value value = Next();
+                v_.PushBack(value);
+                expected_.push_back(value);
+                break;
+            }
+            case kPushBackMove: {
+                Value value = Next();
+                expected_.push_back(value);
+                v_.PushBack(move(value));
+                break;
+            }
+            case kPushBackSelf:
+                if (size != 0) {
+                    const size_t index = input.Upto(size - 1);
+                    v_.PushBack(v_[index]); // Аргумент внутри вектора, который может перевыделиться
+                    const Value copy = expected_[index];
+                    expected_.push_back(copy);
+                }
+                break;
+            case kEmplaceBack: {
+                const Value value = Next();
+                v_.EmplaceBack(value);
+                expected_.emplace_back(value);
+                break;
+            }
+            case kInsertCopy: {
+                const size_t index = input.Upto(size);
+                const Value value = Next();
+                v_.Insert(v_.begin() + index, value);
+                expected_.insert(expected_.begin() + index, value);
+                break;
+            }
+            case kInsertSelf:
+                if (size != 0) {
+                    const size_t index = input.Upto(size);
+                    const size_t source = input.Upto(size - 1);
+                    v_.Insert(v_.begin() + index, v_[source]);
+                    const Value copy = expected_[source];
+                    expected_.insert(expected_.begin() + index, copy);
+                }
+                break;
+            case kEmplace: {
+                const size_t index = input.Upto(size);
+                const Value value = Next();
+                v_.Emplace(v_.begin() + index, value);
+                expected_.emplace(expected_.begin() + index, value);
+                break;
+            }
+            case kErase:
+                if (size != 0) {
+                    const size_t index = input.Upto(size - 1);
+                    v_.Erase(v_.begin() + index);
+                    expected_.erase(expected_.begin() + index);
+                }
+                break;
+            case kPopBack:
+                if (size != 0) {
+                    v_.PopBack();
+                    expected_.pop_back();
+                }
+                break;
+            case kResize: {
+                const size_t new_size = input.Upto(kMaxSize);
+                v_.Resize(new_size);
+                expected_.resize(new_size);
+                break;
+            }
+            case kReserve:
+                v_.Reserve(input.Upto(kMaxSize * 2));
+                break;
+            case kClear:
+                v_.Clear();
+                expected_.clear();
+                break;
+            case kCopyAssign: {
+                Vector copy(v_);
+                v_ = copy;
+                break;
+            }
+            case kMoveAssign: {
+                Vector moved(move(v_));
+                v_ = move(moved);
+                break;
+            }
+            case kSwap: {
+                Vector other;
+                other.PushBack(Next());
+                other.swap(v_);
+                other.swap(v_);
+                break;
+            }
+            default:
+                if constexpr (FullApi) {
+                    ApplyFull(op, input);
+                }
+                break;
+        }
+        if (expected_.size() > kMaxSize * 4) {
+            v_.Clear();
+            expected_.clear();
+        }
+    }
+
+    void ApplyFull(Op op, Input& input) {
+        const size_t size = expected_.size();
+        switch (op) {
+            case kAppend: {
+                vector<Value> tail(input.Upto(16));
+                generate(tail.begin(), tail.end(), [this] {
+                    return Next();
+                });
+                v_.Append(tail.begin(), tail.end());
+                expected_.insert(expected_.end(), tail.begin(), tail.end());
+                break;
+            }
+            case kInsertRange: {
+                const size_t index = input.Upto(size);
+                vector<Value> range(input.Upto(16));
+                generate(range.begin(), range.end(), [this] {
+                    return Next();
+                });
+                v_.InsertRange(v_.begin() + index, range.begin(), range.end());
+                expected_.insert(expected_.begin() + index, range.begin(), range.end());
+                break;
+            }
+            case kEraseRange: {
+                const size_t first = input.Upto(size);
+                const size_t last = first + input.Upto(size - first);
+                v_.EraseRange(v_.begin() + first, v_.begin() + last);
+                expected_.erase(expected_.begin() + first, expected_.begin() + last);
+                break;
+            }
+            case kAssign: {
+                vector<Value> values(input.Upto(32));
+                generate(values.begin(), values.end(), [this] {
+                    return Next();
+                });
+                v_.Assign(values.begin(), values.end());
+                expected_ = values;
+                break;
+            }
+            case kShrinkToFit:
+                v_.ShrinkToFit();
+                if (v_.GetCapacity() != expected_.size()) {
+                    Fail(name_, step_, "ShrinkToFit", "capacity differs from size");
+                }
+                break;
+            case kSwapErase:
+                if (size != 0) {
+                    const size_t index = input.Upto(size - 1);
+                    v_.SwapErase(v_.begin() + index);
+                    if (index != size - 1) {
+                        expected_[index] = move(expected_.back());
+                    }
+                    expected_.pop_back();
+                }
+                break;
+            case kEraseIf: {
+                const size_t modulo = input.Upto(6) + 2;
+                auto pred = [modulo](const Value& value) {
+                    return hash<Value>()(value) % modulo == 0;
+                };
+                const size_t erased = v_.EraseIf(pred);
+                const size_t before = expected_.size();
+                expected_.erase(remove_if(expected_.begin(), expected_.end(), pred), expected_.end());
+                if (erased != before - expected_.size()) {
+                    Fail(name_, step_, "EraseIf", "erased count mismatch");
+                }
+                break;
+            }
+            case kRemoveDuplicates:
+                v_.RemoveDuplicates();
+                expected_.erase(unique(expected_.begin(), expected_.end()), expected_.end());
+                break;
+            default:
+                break;
+        }
+    }
+
+    void Check(const char* op) const {
+        if (v_.GetSize() != expected_.size()) {
+            Fail(name_, step_, op, "size mismatch");
+        }
+        if (v_.GetSize() > v_.GetCapacity()) {
+            Fail(name_, step_, op, "size exceeds capacity");
+        }
+        if (v_.IsEmpty() != expected_.empty()) {
+            Fail(name_, step_, op, "IsEmpty mismatch");
+        }
+        if (!equal(v_.begin(), v_.end(), expected_.begin(), expected_.end())) {
+            Fail(name_, step_, op, "content mismatch");
+        }
+    }
+};
+
+void RunAll(const uint8_t* data, size_t size) {
+    {
+        Input input(data, size);
+        Differential<SimpleVector<int>, true>("SimpleVector<int>").Run(input);
+    }
+    {
+        Input input(data, size);
+        Differential<SimpleVector<string>, true>("SimpleVector<string>").Run(input);
+    }
+    {
+        Input input(data, size);
+        Differential<ReallocSimpleVector<int>, true>("ReallocSimpleVector<int>").Run(input);
+    }
+    {
+        Input input(data, size);
+        Differential<SmallSimpleVector<string, 4>, false>("SmallSimpleVector<string, 4>").Run(input);
+    }
+}
+
+}  // namespace
+
+#ifdef SIMPLE_VECTOR_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    RunAll(data, size);
+    return 0;
+}
+#else
+int main(int argc, char** argv) {
+    const unsigned long runs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 500;
+    uint64_t state = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1;
+
+    vector<uint8_t> data;
+    for (unsigned long run = 0; run < runs; ++run) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data.resize(1 + (state >> 33) % 2048);
+        for (uint8_t& byte : data) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            byte = static_cast<uint8_t>(state >> 56);
+        }
+        RunAll(data.data(), data.size());
+    }
+    printf("simple_vector_fuzz: %lu runs passed\n", runs);
+    return 0;
+}
+#endif
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Двоичная сериализация SimpleVector.
+// Формат: заголовок SerializedVectorHeader и за ним элементы. Тривиально копируемые элементы
+// пишутся сырым буфером одной записью и дополняются нулями до kSerializedAlignment байт,
+// чтобы следующий вектор в том же буфере тоже был выровнен; такой буфер можно
+// читать без копирования через ReadView. Прочие типы пишутся поэлементно через
+// WriteElement/ReadElement, которые пользователь перегружает для своих типов (находятся по ADL).
+// Порядок байт — родной для машины: формат предназначен для обмена между процессами одного хоста.
+
+inline constexpr std::uint64_t kSerializedVectorMagic = 0x314E494256454353; // "SCEVBIN1"
+inline constexpr std::uint32_t kSerializedVectorVersion = 1;
+inline constexpr size_t kSerializedAlignment = 16;
+
+struct SerializedVectorHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t element_size; // 0 — поэлементный формат
+    std::uint64_t size;
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(SerializedVectorHeader) % kSerializedAlignment == 0,
+              "Header must keep the payload aligned");
+
+// Элементы тривиально копируемого типа пишутся сырыми байтами
+template <typename Type>
+inline constexpr bool kSerializeRaw = std::is_trivially_copyable_v<Type>;
+
+// Поэлементная запись встроенных типов
+
+template <typename Type, std::enable_if_t<std::is_trivially_copyable_v<Type>, int> = 0>
+void WriteElement(std::ostream& out, const Type& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(Type));
+}
+
+template <typename Type, std::enable_if_t<std::is_trivially_copyable_v<Type>, int> = 0>
+void ReadElement(std::istream& in, Type& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(Type));
+}
+
+template <typename Char, typename Traits, typename Alloc>
+void WriteElement(std::ostream& out, const std::basic_string<Char, Traits, Alloc>& value) {
+    const std::uint64_t length = value.size();
+    WriteElement(out, length);
+    out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(length * sizeof(Char)));
+}
+
+template <typename Char, typename Traits, typename Alloc>
+void ReadElement(std::istream& in, std::basic_string<Char, Traits, Alloc>& value) {
+    std::uint64_t length = 0;
+    ReadElement(in, length);
+    if (!in) {
+        return;
+    }
+    value.resize(static_cast<size_t>(length));
+    in.read(reinterpret_cast<char*>(value.data()), static_cast<std::streamsize>(length * sizeof(Char)));
+}
+
+// Заголовок для вектора v
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+SerializedVectorHeader MakeSerializedHeader(const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v) noexcept {
+    return {kSerializedVectorMagic, kSerializedVectorVersion,
+            kSerializeRaw<Type> ? static_cast<std::uint32_t>(sizeof(Type)) : 0,
+            v.GetSize(), 0};
+}
+
+// Проверяет заголовок, прочитанный для вектора элементов Type
+template <typename Type>
+void ValidateSerializedHeader(const SerializedVectorHeader& header) {
+    if (header.magic != kSerializedVectorMagic) {
+        throw std::runtime_error("Not a serialized vector");
+    }
+    if (header.version != kSerializedVectorVersion) {
+        throw std::runtime_error("Unsupported serialized vector version");
+    }
+    if (header.element_size != (kSerializeRaw<Type> ? sizeof(Type) : 0)) {
+        throw std::runtime_error("Serialized vector element size mismatch");
+    }
+}
+
+// Число нулевых байт после сырых данных длиной bytes
+inline size_t SerializedPadding(size_t bytes) noexcept {
+    return (kSerializedAlignment - bytes % kSerializedAlignment) % kSerializedAlignment;
+}
+
+// Запись в поток. Бросает std::runtime_error, если поток перешёл в состояние ошибки
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void WriteTo(std::ostream& out, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v) {
+    const SerializedVectorHeader header = MakeSerializedHeader(v);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if constexpr (kSerializeRaw<Type>) {
+        static constexpr char kZeros[kSerializedAlignment] = {};
+        const size_t bytes = v.GetSize() * sizeof(Type);
+        out.write(reinterpret_cast<const char*>(v.begin()), static_cast<std::streamsize>(bytes));
+        out.write(kZeros, static_cast<std::streamsize>(SerializedPadding(bytes)));
+    }
+    else {
+        for (const Type& item : v) {
+            WriteElement(out, item);
+        }
+    }
+    if (!out) {
+        throw std::runtime_error("Failed to write serialized vector");
+    }
+}
+
+// Чтение из потока с заменой содержимого v. Сырые данные читаются одним вызовом
+// прямо в буфер вектора. Бросает std::runtime_error при неверном заголовке или обрыве данных
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void ReadFrom(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v) {
+    SerializedVectorHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Truncated serialized vector");
+    }
+    ValidateSerializedHeader<Type>(header);
+    const size_t size = static_cast<size_t>(header.size);
+
+    v.Clear();
+    if constexpr (kSerializeRaw<Type>) {
+        v.Reserve(size);
+        v.ConstructBack(size, [&](Type* raw, size_t count) {
+            const size_t bytes = count * sizeof(Type);
+            if (!in.read(reinterpret_cast<char*>(raw), static_cast<std::streamsize>(bytes))
+                || !in.ignore(static_cast<std::streamsize>(SerializedPadding(bytes)))) {
+                throw std::runtime_error("Truncated serialized vector");
+            }
+        });
+    }
+    else {
+        for (size_t i = 0; i < size; ++i) {
+            Type item{};
+            ReadElement(in, item);
+            if (!in) {
+                throw std::runtime_error("Truncated serialized vector");
+            }
+            v.PushBack(std::move(item));
+        }
+    }
+}
+
+// Вложенные векторы пишутся поэлементно целиком, со своим заголовком
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void WriteElement(std::ostream& out, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& value) {
+    WriteTo(out, value);
+}
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void ReadElement(std::istream& in, SimpleVector<Type, Allocator, GrowthPolicy, Stats>& value) {
+    ReadFrom(in, value);
+}
+
+// Пишет count частей parts целиком, повторяя writev после частичной записи
+inline void WriteAllVectored(int fd, iovec* parts, size_t count) {
+    while (count != 0) {
+        const int batch = static_cast<int>(std::min<size_t>(count, IOV_MAX));
+        const ssize_t written = ::writev(fd, parts, batch);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+
+        size_t left = static_cast<size_t>(written);
+        while (count != 0 && left >= parts->iov_len) {
+            left -= parts->iov_len;
+            ++parts;
+            --count;
+        }
+        if (count != 0) {
+            parts->iov_base = static_cast<char*>(parts->iov_base) + left;
+            parts->iov_len -= left;
+        }
+    }
+}
+
+// Читает ровно bytes байт из fd
+inline void ReadAll(int fd, void* buffer, size_t bytes) {
+    char* dest = static_cast<char*>(buffer);
+    while (bytes != 0) {
+        const ssize_t got = ::read(fd, dest, bytes);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (got == 0) {
+            throw std::runtime_error("Truncated serialized vector");
+        }
+        dest += got;
+        bytes -= static_cast<size_t>(got);
+    }
+}
+
+// Записывает несколько векторов тривиально копируемых типов подряд одним вызовом writev
+// (при частичной записи — несколькими): заголовки, данные и выравнивание идут
+// частями scatter-gather без промежуточного буфера
+template <typename... Vectors>
+void WriteVectors(int fd, const Vectors&... vectors) {
+    static_assert(sizeof...(Vectors) > 0, "Nothing to write");
+    static char zeros[kSerializedAlignment] = {}; // writev не пишет в буфер, но требует не-const
+
+    std::array<SerializedVectorHeader, sizeof...(Vectors)> headers = {MakeSerializedHeader(vectors)...};
+    std::array<iovec, 3 * sizeof...(Vectors)> parts;
+    size_t part = 0;
+    auto add = [&](const auto& v) {
+        using Type = std::remove_cv_t<std::remove_reference_t<decltype(*v.begin())>>;
+        static_assert(kSerializeRaw<Type>, "Vectored writes need trivially copyable elements");
+        const size_t bytes = v.GetSize() * sizeof(Type);
+        parts[part] = {&headers[part / 3], sizeof(SerializedVectorHeader)};
+        parts[part + 1] = {const_cast<Type*>(v.begin()), bytes};
+        parts[part + 2] = {zeros, SerializedPadding(bytes)};
+        part += 3;
+    };
+    (add(vectors), ...);
+    WriteAllVectored(fd, parts.data(), parts.size());
+}
+
+// Запись вектора тривиально копируемых элементов в файловый дескриптор
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void WriteTo(int fd, const SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v) {
+    WriteVectors(fd, v);
+}
+
+// Чтение вектора тривиально копируемых элементов из файлового дескриптора с заменой содержимого v
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Stats>
+void ReadFrom(int fd, SimpleVector<Type, Allocator, GrowthPolicy, Stats>& v) {
+    static_assert(kSerializeRaw<Type>, "Descriptor reads need trivially copyable elements");
+    SerializedVectorHeader header;
+    ReadAll(fd, &header, sizeof(header));
+    ValidateSerializedHeader<Type>(header);
+    const size_t size = static_cast<size_t>(header.size);
+
+    v.Clear();
+    v.Reserve(size);
+    v.ConstructBack(size, [&](Type* raw, size_t count) {
+        char padding[kSerializedAlignment];
+        const size_t bytes = count * sizeof(Type);
+        ReadAll(fd, raw, bytes);
+        ReadAll(fd, padding, SerializedPadding(bytes));
+    });
+}
+
+// Представление вектора, сериализованного в buffer, без копирования элементов.
+// В consumed записывается длина вектора в буфере вместе с выравниванием, т. е. смещение
+// следующего вектора. Бросает std::runtime_error при неверном заголовке, нехватке данных
+// или если элементы в буфере не выровнены для Type
+template <typename Type>
+SimpleVectorView<const Type> ReadView(const void* buffer, size_t bytes, size_t* consumed = nullptr) {
+    static_assert(kSerializeRaw<Type>, "Views need trivially copyable elements");
+    SerializedVectorHeader header;
+    if (bytes < sizeof(header)) {
+        throw std::runtime_error("Truncated serialized vector");
+    }
+    std::memcpy(&header, buffer, sizeof(header));
+    ValidateSerializedHeader<Type>(header);
+    if (header.size > (bytes - sizeof(header)) / sizeof(Type)) {
+        throw std::runtime_error("Truncated serialized vector");
+    }
+
+    const size_t size = static_cast<size_t>(header.size);
+    const char* data = static_cast<const char*>(buffer) + sizeof(header);
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(Type) != 0) {
+        throw std::runtime_error("Serialized vector is misaligned");
+    }
+    if (consumed != nullptr) {
+        const size_t payload = size * sizeof(Type);
+        *consumed = std::min(bytes, sizeof(header) + payload + SerializedPadding(payload));
+    }
+    return {reinterpret_cast<const Type*>(data), size};
+}
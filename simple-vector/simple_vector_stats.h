@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include "relocate.h"
+
+// Места, где вектор выделяет память
+enum class GrowthSite {
+    kConstruct,
+    kPushBack,
+    kInsert,
+    kResize,
+    kReserve,
+    kAssign,
+    kShrink,
+};
+
+inline constexpr size_t kGrowthSiteCount = static_cast<size_t>(GrowthSite::kShrink) + 1;
+
+// Снимок счётчиков для выгрузки в систему метрик
+struct VectorStatsSnapshot {
+    size_t allocations = 0;
+    std::array<size_t, kGrowthSiteCount> reallocations{}; // Индекс — GrowthSite
+    size_t elements_relocated_bitwise = 0;
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    size_t peak_size = 0;
+    size_t peak_capacity = 0;
+
+    size_t GetReallocations(GrowthSite site) const noexcept {
+        return reallocations[static_cast<size_t>(site)];
+    }
+};
+
+// Политика статистики по умолчанию: все хуки пустые и встраиваются в ничто,
+// а [[no_unique_address]] убирает её из размера вектора
+struct NoVectorStats {
+    void OnAllocate(GrowthSite /*site*/, bool /*reallocation*/) noexcept {}
+
+    template <typename Type>
+    void OnRelocate(size_t /*count*/) noexcept {}
+
+    void OnSize(size_t /*size*/, size_t /*capacity*/) noexcept {}
+
+    VectorStatsSnapshot Snapshot() const noexcept {
+        return {};
+    }
+};
+
+// Счётчики выделений, перевыделений по местам роста, перенесённых элементов и пиков
+class VectorStats {
+public:
+    void OnAllocate(GrowthSite site, bool reallocation) noexcept {
+        ++snapshot_.allocations;
+        if (reallocation) {
+            ++snapshot_.reallocations[static_cast<size_t>(site)];
+        }
+    }
+
+    // Учитывает перенос count элементов тем способом, который выберет UninitializedRelocate
+    template <typename Type>
+    void OnRelocate(size_t count) noexcept {
+        if constexpr (kRelocateBitwise<Type>) {
+            snapshot_.elements_relocated_bitwise += count;
+        }
+        else if constexpr (kRelocateByMove<Type>) {
+            snapshot_.elements_moved += count;
+        }
+        else {
+            snapshot_.elements_copied += count;
+        }
+    }
+
+    void OnSize(size_t size, size_t capacity) noexcept {
+        snapshot_.peak_size = std::max(snapshot_.peak_size, size);
+        snapshot_.peak_capacity = std::max(snapshot_.peak_capacity, capacity);
+    }
+
+    const VectorStatsSnapshot& Snapshot() const noexcept {
+        return snapshot_;
+    }
+
+private:
+    VectorStatsSnapshot snapshot_;
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "simd_kernels.h"
+#include "simple_vector.h"
+
+// Невладеющее представление непрерывного диапазона элементов: части SimpleVector
+// или буфера, полученного из другого процесса. Память должна жить дольше представления.
+// SimpleVector неявно преобразуется в представление, а нарезка не выделяет память.
+// SimpleVectorView<const Type> (ConstSimpleVectorView<Type>) только читает элементы
+template <typename Type>
+class SimpleVectorView {
+    using ValueType = std::remove_const_t<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept
+        : data_(data), size_(size) {}
+
+    // Представление всего вектора
+    template <typename Allocator, typename GrowthPolicy, typename Stats>
+    SimpleVectorView(SimpleVector<ValueType, Allocator, GrowthPolicy, Stats>& v) noexcept
+        : data_(v.begin()), size_(v.GetSize()) {}
+
+    template <typename Allocator, typename GrowthPolicy, typename Stats, typename T = Type,
+              std::enable_if_t<std::is_const_v<T>, int> = 0>
+    SimpleVectorView(const SimpleVector<ValueType, Allocator, GrowthPolicy, Stats>& v) noexcept
+        : data_(v.begin()), size_(v.GetSize()) {}
+
+    // Изменяемое представление сужается до константного
+    template <typename T = Type, std::enable_if_t<std::is_const_v<T>, int> = 0>
+    SimpleVectorView(SimpleVectorView<ValueType> other) noexcept
+        : data_(other.Data()), size_(other.GetSize()) {}
+
+    // Оператор индексирования
+    Type& operator[](size_t index) const noexcept {
+        assert(index < size_ && "Index out of range");
+        return data_[index];
+    }
+
+    // Метод At с проверкой границ
+    Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return data_[index];
+    }
+
+    // Элементы [offset, offset + count); count обрезается по концу представления
+    SimpleVectorView Subview(size_t offset, size_t count = SIZE_MAX) const {
+        if (offset > size_) {
+            throw std::out_of_range("Subview offset out of range");
+        }
+        return {data_ + offset, std::min(count, size_ - offset)};
+    }
+
+    // Первые count элементов
+    SimpleVectorView First(size_t count) const {
+        if (count > size_) {
+            throw std::out_of_range("First count out of range");
+        }
+        return {data_, count};
+    }
+
+    // Последние count элементов
+    SimpleVectorView Last(size_t count) const {
+        if (count > size_) {
+            throw std::out_of_range("Last count out of range");
+        }
+        return {data_ + size_ - count, count};
+    }
+
+    Iterator begin() const noexcept {
+        return data_;
+    }
+
+    Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    Type* Data() const noexcept {
+        return data_;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Первый элемент, равный value, или end()
+    Iterator Find(const ValueType& value) const {
+        return data_ + RangeFind(data_, size_, value);
+    }
+
+    // Количество элементов, равных value
+    size_t Count(const ValueType& value) const {
+        return RangeCount(data_, size_, value);
+    }
+
+    bool Contains(const ValueType& value) const {
+        return Find(value) != end();
+    }
+
+    // Операторы сравнения объявлены друзьями, чтобы сравнение с SimpleVector
+    // и с изменяемым представлением шло через неявное преобразование
+
+    friend bool operator<(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return RangeLess(lhs.data_, lhs.size_, rhs.data_, rhs.size_);
+    }
+
+    friend bool operator==(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return lhs.size_ == rhs.size_ && RangeEqual(lhs.data_, rhs.data_, lhs.size_);
+    }
+
+    friend bool operator!=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator>(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs > rhs);
+    }
+
+    friend bool operator>=(SimpleVectorView lhs, SimpleVectorView rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Type>
+using ConstSimpleVectorView = SimpleVectorView<const Type>;
@@ -0,0 +1,367 @@
+#pragma once
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "simd_kernels.h"
+#include "simple_vector.h" // ReserveProxyObj
+
+// Вектор, хранящий до N элементов внутри себя и уходящий в кучу только при переполнении
+template <typename Type, size_t N, typename GrowthPolicy = DoublingGrowth>
+class SmallSimpleVector {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+    using Storage = ArrayPtr<Type>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Конструктор по умолчанию
+    SmallSimpleVector() noexcept {}
+
+    // Конструктор с заданным размером
+    explicit SmallSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    // Конструктор с резервированием ёмкости (элементы не создаются)
+    explicit SmallSimpleVector(ReserveProxyObj obj) {
+        Reserve(obj.GetCapacity());
+    }
+
+    // Конструктор с заданным размером и значением
+    SmallSimpleVector(size_t size, const Type& value) {
+        Reserve(size);
+        std::uninitialized_fill_n(Data(), size, value);
+        size_ = size;
+    }
+
+    // Конструктор с initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init) {
+        Reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), Data());
+        size_ = init.size();
+    }
+
+    ~SmallSimpleVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+    // Конструктор копирования
+    SmallSimpleVector(const SmallSimpleVector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    // Конструктор перемещения: буфер из кучи забирается целиком, встроенные элементы переносятся
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        StealFrom(other);
+    }
+
+    // Оператор присваивания
+    SmallSimpleVector& operator=(const SmallSimpleVector& other) {
+        if (this != &other) {
+            SmallSimpleVector tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    // Оператор перемещающего присваивания
+    SmallSimpleVector& operator=(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &other) {
+            Clear();
+            heap_ = Storage();
+            StealFrom(other);
+        }
+        return *this;
+    }
+
+    // Оператор индексирования
+    Type& operator[](size_t index) noexcept {
+        assert(index < size_ && "Index out of range");
+        return Data()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        assert(index < size_ && "Index out of range");
+        return Data()[index];
+    }
+
+    // Метод At с проверкой границ
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return Data()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return Data()[index];
+    }
+
+    // Изменение размера вектора
+    void Resize(size_t new_size) {
+        if (new_size > GetCapacity()) {
+            Reallocate(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)));
+        }
+
+        if (new_size > size_) {
+            std::uninitialized_value_construct(end(), begin() + new_size);
+        }
+        else {
+            std::destroy(begin() + new_size, end());
+        }
+
+        size_ = new_size;
+    }
+
+    // Итераторы
+    Iterator begin() noexcept {
+        return Data();
+    }
+
+    Iterator end() noexcept {
+        return Data() + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return Data() + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator cend() const noexcept {
+        return Data() + size_;
+    }
+
+    // Получение размера
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Получение емкости
+    size_t GetCapacity() const noexcept {
+        return heap_ ? heap_.GetSize() : N;
+    }
+
+    // Проверка на пустоту
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Элементы лежат во встроенном буфере
+    bool IsInline() const noexcept {
+        return !heap_;
+    }
+
+    // Очистка вектора
+    void Clear() noexcept {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+    }
+
+    // Добавление элемента в конец
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Вставка элемента
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создание элемента в конце прямо из аргументов конструктора
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAt(size_, std::forward<Args>(args)...);
+    }
+
+    // Создание элемента перед pos прямо из аргументов конструктора
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        if (pos < begin() || pos > end()) {
+            throw std::out_of_range("Insert position out of range");
+        }
+        return EmplaceAt(pos - cbegin(), std::forward<Args>(args)...);
+    }
+
+    // Удаление последнего элемента
+    void PopBack() noexcept {
+        assert(size_ > 0 && "PopBack called on an empty container");
+        --size_;
+        std::destroy_at(Data() + size_);
+    }
+
+    // Удаление элемента
+    Iterator Erase(ConstIterator pos) {
+        if (size_ == 0) {
+            throw std::out_of_range("Cannot erase from an empty container");
+        }
+        if (pos < begin() || pos >= end()) {
+            throw std::out_of_range("Erase position out of range");
+        }
+
+        Iterator non_const_pos = begin() + (pos - cbegin());
+        ShiftLeft(non_const_pos, end() - non_const_pos - 1, 1);
+        PopBack();
+
+        return non_const_pos;
+    }
+
+    // Обмен с другим вектором. Дёшев, только когда оба вектора в куче
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (heap_ && other.heap_) {
+            heap_.swap(other.heap_);
+            std::swap(size_, other.size_);
+            return;
+        }
+        SmallSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    // Метод Reserve
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Reallocate(new_capacity);
+        }
+    }
+
+private:
+    alignas(Type) unsigned char inline_[sizeof(Type) * N];
+    size_t size_ = 0;
+    Storage heap_; // Пуст, пока элементы помещаются во встроенный буфер
+
+    Type* Data() noexcept {
+        return heap_ ? heap_.Get() : std::launder(reinterpret_cast<Type*>(inline_));
+    }
+
+    const Type* Data() const noexcept {
+        return heap_ ? heap_.Get() : std::launder(reinterpret_cast<const Type*>(inline_));
+    }
+
+    // Забирает содержимое other; *this должен быть пуст и без буфера в куче
+    void StealFrom(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (other.heap_) {
+            heap_ = std::move(other.heap_);
+        }
+        else {
+            std::uninitialized_move_n(other.Data(), other.size_, Data());
+            std::destroy_n(other.Data(), other.size_);
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Переносит живые элементы в буфер кучи ёмкостью new_capacity
+    void Reallocate(size_t new_capacity) {
+        Storage new_data(new_capacity);
+        UninitializedRelocate(Data(), size_, new_data.Get());
+        DestroyRelocated(Data(), size_);
+        heap_ = std::move(new_data);
+    }
+
+    // Создаёт элемент из args на позиции index, сдвигая хвост вправо
+    template <typename... Args>
+    Iterator EmplaceAt(size_t index, Args&&... args) {
+        assert(index <= size_);
+
+        if (size_ == GetCapacity()) {
+            Storage new_data(GrowthPolicy::NextCapacity(GetCapacity(), size_ + 1, sizeof(Type)));
+            Type* slot = new_data.Get() + index;
+
+            // Новый элемент создаётся первым: args могут ссылаться на элементы старого буфера
+            ::new (static_cast<void*>(slot)) Type(std::forward<Args>(args)...);
+            try {
+                UninitializedRelocate(Data(), index, new_data.Get());
+            }
+            catch (...) {
+                std::destroy_at(slot);
+                throw;
+            }
+            try {
+                UninitializedRelocate(Data() + index, size_ - index, slot + 1);
+            }
+            catch (...) {
+                std::destroy(new_data.Get(), slot + 1);
+                throw;
+            }
+
+            DestroyRelocated(Data(), size_);
+            heap_ = std::move(new_data);
+        }
+        else if (index == size_) {
+            ::new (static_cast<void*>(end())) Type(std::forward<Args>(args)...);
+        }
+        else {
+            // Элемент собирается до сдвига: args могут ссылаться на сдвигаемые элементы
+            Type tmp(std::forward<Args>(args)...);
+            ShiftRightByOne(begin() + index, size_ - index);
+            ++size_;
+            Data()[index] = std::move(tmp);
+            return begin() + index;
+        }
+
+        ++size_;
+        return begin() + index;
+    }
+};
+
+// Операторы сравнения
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator<(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return RangeLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator==(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() &&
+        RangeEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator!=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator>(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator<=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, size_t N, typename GrowthPolicy>
+inline bool operator>=(const SmallSimpleVector<Type, N, GrowthPolicy>& lhs, const SmallSimpleVector<Type, N, GrowthPolicy>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "array_ptr.h"
+#include "growth_policy.h"
+#include "relocate.h"
+#include "simd_kernels.h"
+#include "simple_vector_view.h"
+
+// Вектор записей из полей Ts..., где каждое поле хранится в собственном непрерывном
+// столбце (structure of arrays). Цикл, которому нужна пара полей, читает только их столбцы.
+// Рост, Reserve и PushBack ведут себя как у SimpleVector; все столбцы имеют общую ёмкость.
+// Строка доступна как std::tuple ссылок на поля, так что работают структурные привязки
+// и std::get; Column<I>() отдаёт поле I как непрерывное представление для векторных ядер
+template <typename GrowthPolicy, typename... Ts>
+class BasicSoASimpleVector {
+    static_assert(sizeof...(Ts) > 0, "At least one field is required");
+
+    using Columns = std::tuple<ArrayPtr<Ts>...>;
+    using Indices = std::index_sequence_for<Ts...>;
+
+    // Байт на строку: размер «элемента» для политики роста
+    static constexpr size_t kRowBytes = (sizeof(Ts) + ...);
+
+    template <typename Owner, typename Reference>
+    class BasicIterator;
+
+public:
+    using Value = std::tuple<Ts...>;
+    using Reference = std::tuple<Ts&...>;
+    using ConstReference = std::tuple<const Ts&...>;
+    using Iterator = BasicIterator<BasicSoASimpleVector, Reference>;
+    using ConstIterator = BasicIterator<const BasicSoASimpleVector, ConstReference>;
+
+    template <size_t I>
+    using ColumnType = std::tuple_element_t<I, Value>;
+
+    // Конструктор по умолчанию
+    BasicSoASimpleVector() noexcept = default;
+
+    // Конструктор с заданным размером
+    explicit BasicSoASimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    BasicSoASimpleVector(std::initializer_list<Value> init) {
+        Reserve(init.size());
+        for (const Value& row : init) {
+            PushBack(row);
+        }
+    }
+
+    ~BasicSoASimpleVector() {
+        DestroyRows(0, size_, Indices{});
+    }
+
+    BasicSoASimpleVector(const BasicSoASimpleVector& other) {
+        Reserve(other.size_);
+        CopyRows(other, Indices{});
+        size_ = other.size_;
+    }
+
+    BasicSoASimpleVector(BasicSoASimpleVector&& other) noexcept
+        : columns_(std::move(other.columns_)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0)) {}
+
+    BasicSoASimpleVector& operator=(const BasicSoASimpleVector& other) {
+        if (this != &other) {
+            BasicSoASimpleVector tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    BasicSoASimpleVector& operator=(BasicSoASimpleVector&& other) noexcept {
+        if (this != &other) {
+            BasicSoASimpleVector tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    // Строка index как кортеж ссылок на её поля
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_ && "Index out of range");
+        return Row<Reference>(*this, index, Indices{});
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < size_ && "Index out of range");
+        return Row<ConstReference>(*this, index, Indices{});
+    }
+
+    Reference At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Столбец поля I
+    template <size_t I>
+    SimpleVectorView<ColumnType<I>> Column() noexcept {
+        return {std::get<I>(columns_).Get(), size_};
+    }
+
+    template <size_t I>
+    ConstSimpleVectorView<ColumnType<I>> Column() const noexcept {
+        return {std::get<I>(columns_).Get(), size_};
+    }
+
+    // Итераторы по строкам
+    Iterator begin() noexcept {
+        return {this, 0};
+    }
+
+    Iterator end() noexcept {
+        return {this, size_};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {this, size_};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Очистка вектора
+    void Clear() noexcept {
+        DestroyRows(0, size_, Indices{});
+        size_ = 0;
+    }
+
+    // Добавление строки в конец
+    void PushBack(const Value& row) {
+        std::apply([this](const Ts&... fields) {
+            EmplaceBack(fields...);
+        }, row);
+    }
+
+    void PushBack(Value&& row) {
+        std::apply([this](Ts&... fields) {
+            EmplaceBack(std::move(fields)...);
+        }, row);
+    }
+
+    // Создание строки в конце: по одному аргументу конструктора на каждое поле
+    template <typename... Args>
+    void EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "One argument per field is required");
+        if (size_ == capacity_) {
+            // Строка собирается до перевыделения: args могут ссылаться на поля этого вектора
+            Value row(std::forward<Args>(args)...);
+            Reallocate(GrowthPolicy::NextCapacity(capacity_, size_ + 1, kRowBytes));
+            std::apply([this](Ts&... fields) {
+                ConstructRow(size_, Indices{}, std::move(fields)...);
+            }, row);
+        }
+        else {
+            ConstructRow(size_, Indices{}, std::forward<Args>(args)...);
+        }
+        ++size_;
+    }
+
+    // Удаление последней строки
+    void PopBack() noexcept {
+        assert(size_ > 0 && "PopBack called on an empty container");
+        --size_;
+        DestroyRows(size_, size_ + 1, Indices{});
+    }
+
+    // Изменение размера; новые строки инициализируются значениями по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size > capacity_) {
+            Reallocate(GrowthPolicy::NextCapacity(capacity_, new_size, kRowBytes));
+        }
+        if (new_size > size_) {
+            ValueConstructRows(new_size, Indices{});
+        }
+        else {
+            DestroyRows(new_size, size_, Indices{});
+        }
+        size_ = new_size;
+    }
+
+    // Метод Reserve
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    void swap(BasicSoASimpleVector& other) noexcept {
+        columns_.swap(other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+private:
+    Columns columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    template <typename Ref, typename Self, size_t... I>
+    static Ref Row(Self& self, size_t index, std::index_sequence<I...>) noexcept {
+        return Ref(std::get<I>(self.columns_)[index]...);
+    }
+
+    template <size_t... I>
+    void DestroyRows(size_t first, size_t last, std::index_sequence<I...>) noexcept {
+        (std::destroy(std::get<I>(columns_).Get() + first, std::get<I>(columns_).Get() + last), ...);
+    }
+
+    // Разрушает поле строки index в первых count столбцах
+    template <size_t... I>
+    void DestroyFields(size_t index, size_t count, std::index_sequence<I...>) noexcept {
+        ((I < count ? std::destroy_at(std::get<I>(columns_).Get() + index) : void()), ...);
+    }
+
+    // Создаёт поля строки index; при исключении разрушает уже созданные поля
+    template <size_t... I, typename... Args>
+    void ConstructRow(size_t index, std::index_sequence<I...>, Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((::new (static_cast<void*>(std::get<I>(columns_).Get() + index)) Ts(std::forward<Args>(args)),
+              ++constructed), ...);
+        }
+        catch (...) {
+            DestroyFields(index, constructed, Indices{});
+            throw;
+        }
+    }
+
+    // Создаёт строки [size_, new_size) по столбцам; при исключении вектор не меняется
+    template <size_t... I>
+    void ValueConstructRows(size_t new_size, std::index_sequence<I...>) {
+        size_t constructed = 0;
+        try {
+            ((std::uninitialized_value_construct(std::get<I>(columns_).Get() + size_,
+                                                 std::get<I>(columns_).Get() + new_size),
+              ++constructed), ...);
+        }
+        catch (...) {
+            ((I < constructed ? std::destroy(std::get<I>(columns_).Get() + size_,
+                                             std::get<I>(columns_).Get() + new_size) : void()), ...);
+            throw;
+        }
+    }
+
+    // Копирует строки other в пустые столбцы достаточной ёмкости
+    template <size_t... I>
+    void CopyRows(const BasicSoASimpleVector& other, std::index_sequence<I...>) {
+        size_t copied = 0;
+        try {
+            ((std::uninitialized_copy_n(std::get<I>(other.columns_).Get(), other.size_, std::get<I>(columns_).Get()),
+              ++copied), ...);
+        }
+        catch (...) {
+            ((I < copied ? (void)std::destroy_n(std::get<I>(columns_).Get(), other.size_) : void()), ...);
+            throw;
+        }
+    }
+
+    // Переносит строки в новые столбцы ёмкостью new_capacity. Выделение и перенос идут
+    // для всех столбцов до того, как старые элементы разрушаются. Столбцы, перенос которых
+    // может бросить (копированием), переносятся первыми, а перемещаемые — только после них,
+    // поэтому при исключении вектор остаётся прежним. Исключение — столбец некопируемого типа
+    // с бросающим перемещением: как и у SimpleVector, его элементы могут остаться перемещёнными
+    void Reallocate(size_t new_capacity) {
+        Columns fresh{ArrayPtr<Ts>(new_capacity)...};
+        RelocateInto(fresh, Indices{});
+        columns_.swap(fresh);
+        capacity_ = new_capacity;
+    }
+
+    template <size_t... I>
+    void RelocateInto(Columns& fresh, std::index_sequence<I...>) {
+        bool relocated[sizeof...(Ts)] = {};
+        try {
+            ((kRelocateNothrow<Ts> ? void() : RelocateColumn<I>(fresh, relocated)), ...);
+        }
+        catch (...) {
+            ((relocated[I] ? DiscardRelocated(std::get<I>(fresh).Get(), size_) : void()), ...);
+            throw;
+        }
+        ((kRelocateNothrow<Ts> ? RelocateColumn<I>(fresh, relocated) : void()), ...);
+        (DestroyRelocated(std::get<I>(columns_).Get(), size_), ...);
+    }
+
+    template <size_t I>
+    void RelocateColumn(Columns& fresh, bool* relocated) {
+        UninitializedRelocate(std::get<I>(columns_).Get(), size_, std::get<I>(fresh).Get());
+        relocated[I] = true;
+    }
+};
+
+// Итератор по строкам; разыменование даёт кортеж ссылок
+template <typename GrowthPolicy, typename... Ts>
+template <typename Owner, typename Reference>
+class BasicSoASimpleVector<GrowthPolicy, Ts...>::BasicIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::tuple<Ts...>;
+    using difference_type = std::ptrdiff_t;
+    using reference = Reference;
+    using pointer = void;
+
+    BasicIterator() noexcept = default;
+
+    BasicIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index) {}
+
+    // Изменяемый итератор приводится к константному
+    operator BasicIterator<const Owner, ConstReference>() const noexcept {
+        return {owner_, index_};
+    }
+
+    Reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+
+    Reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    BasicIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    BasicIterator operator++(int) noexcept {
+        BasicIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    BasicIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    BasicIterator operator--(int) noexcept {
+        BasicIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    BasicIterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+
+    BasicIterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+
+    friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+
+    friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+private:
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+template <typename... Ts>
+using SoASimpleVector = BasicSoASimpleVector<DoublingGrowth, Ts...>;
+
+// Операторы сравнения: столбцы сравниваются целиком векторными ядрами
+
+template <typename GrowthPolicy, typename... Ts, size_t... I>
+bool SoAColumnsEqual(const BasicSoASimpleVector<GrowthPolicy, Ts...>& lhs,
+                     const BasicSoASimpleVector<GrowthPolicy, Ts...>& rhs, std::index_sequence<I...>) {
+    return (RangeEqual(lhs.template Column<I>().begin(), rhs.template Column<I>().begin(), lhs.GetSize()) && ...);
+}
+
+template <typename GrowthPolicy, typename... Ts>
+bool operator==(const BasicSoASimpleVector<GrowthPolicy, Ts...>& lhs, const BasicSoASimpleVector<GrowthPolicy, Ts...>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && SoAColumnsEqual(lhs, rhs, std::index_sequence_for<Ts...>{});
+}
+
+template <typename GrowthPolicy, typename... Ts>
+bool operator!=(const BasicSoASimpleVector<GrowthPolicy, Ts...>& lhs, const BasicSoASimpleVector<GrowthPolicy, Ts...>& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "simd_kernels.h"
+
+// Политики переполнения StaticSimpleVector. OnOverflow вызывается, когда операция не помещается
+// в ёмкость; если он вернул управление, операция ничего не меняет и сообщает о неудаче
+// (false или end()). У AssertOnOverflow и ThrowOnOverflow он не constexpr, поэтому
+// переполнение при вычислении на этапе компиляции — ошибка компиляции.
+
+// assert в отладочной сборке, тихая неудача в релизной
+struct AssertOnOverflow {
+    static void OnOverflow() {
+        assert(false && "StaticSimpleVector capacity exceeded");
+    }
+};
+
+// Исключение std::length_error
+struct ThrowOnOverflow {
+    static void OnOverflow() {
+        throw std::length_error("StaticSimpleVector capacity exceeded");
+    }
+};
+
+// Только возвращаемое значение: вызывающий проверяет результат
+struct FailOnOverflow {
+    static constexpr void OnOverflow() noexcept {}
+};
+
+// Истинно на этапе компиляции; там векторные ядра недоступны
+constexpr bool IsConstantEvaluated() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Вектор ёмкостью N без обращений к куче, полностью пригодный для constexpr.
+// В C++17 в constexpr нельзя создавать объекты в сырой памяти, поэтому все N слотов —
+// значения Type{}, а элементы за концом хранятся как Type{}: тип должен иметь
+// конструктор по умолчанию, освобождённые слоты сбрасываются в Type{}
+template <typename Type, size_t N, typename OverflowPolicy = AssertOnOverflow>
+class StaticSimpleVector {
+    static_assert(std::is_default_constructible_v<Type>, "StaticSimpleVector slots are default-constructed");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Конструктор по умолчанию
+    constexpr StaticSimpleVector() = default;
+
+    // Конструктор с заданным размером
+    constexpr explicit StaticSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    // Конструктор с заданным размером и значением
+    constexpr StaticSimpleVector(size_t size, const Type& value) {
+        if (size > N) {
+            OverflowPolicy::OnOverflow();
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            data_[i] = value;
+        }
+        size_ = size;
+    }
+
+    // Конструктор с initializer_list
+    constexpr StaticSimpleVector(std::initializer_list<Type> init) {
+        if (init.size() > N) {
+            OverflowPolicy::OnOverflow();
+            return;
+        }
+        for (const Type& item : init) {
+            data_[size_++] = item;
+        }
+    }
+
+    // Оператор индексирования
+    constexpr Type& operator[](size_t index) noexcept {
+        assert(index < size_ && "Index out of range");
+        return data_[index];
+    }
+
+    constexpr const Type& operator[](size_t index) const noexcept {
+        assert(index < size_ && "Index out of range");
+        return data_[index];
+    }
+
+    // Метод At с проверкой границ
+    constexpr Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return data_[index];
+    }
+
+    constexpr const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return data_[index];
+    }
+
+    // Изменение размера; новые элементы — Type{}
+    constexpr bool Resize(size_t new_size) {
+        if (new_size > N) {
+            OverflowPolicy::OnOverflow();
+            return false;
+        }
+        for (size_t i = new_size; i < size_; ++i) {
+            data_[i] = Type();
+        }
+        size_ = new_size;
+        return true;
+    }
+
+    // Итераторы
+    constexpr Iterator begin() noexcept {
+        return data_;
+    }
+
+    constexpr Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    constexpr ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    constexpr ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    constexpr ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Получение размера
+    constexpr size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Ёмкость известна на этапе компиляции
+    static constexpr size_t GetCapacity() noexcept {
+        return N;
+    }
+
+    // Проверка на пустоту
+    constexpr bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr bool IsFull() const noexcept {
+        return size_ == N;
+    }
+
+    // Очистка вектора
+    constexpr void Clear() {
+        Resize(0);
+    }
+
+    // Добавление элемента в конец
+    constexpr bool PushBack(const Type& item) {
+        return EmplaceBack(item);
+    }
+
+    constexpr bool PushBack(Type&& item) {
+        return EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    constexpr bool EmplaceBack(Args&&... args) {
+        if (size_ == N) {
+            OverflowPolicy::OnOverflow();
+            return false;
+        }
+        data_[size_] = Type(std::forward<Args>(args)...);
+        ++size_;
+        return true;
+    }
+
+    // Вставка элемента; при переполнении возвращает end()
+    constexpr Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    constexpr Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    constexpr Iterator Emplace(ConstIterator pos, Args&&... args) {
+        if (pos < begin() || pos > end()) {
+            throw std::out_of_range("Insert position out of range");
+        }
+        if (size_ == N) {
+            OverflowPolicy::OnOverflow();
+            return end();
+        }
+        const size_t index = pos - cbegin();
+        Type tmp(std::forward<Args>(args)...); // args могут ссылаться на сдвигаемые элементы
+        for (size_t i = size_; i > index; --i) {
+            data_[i] = std::move(data_[i - 1]);
+        }
+        data_[index] = std::move(tmp);
+        ++size_;
+        return begin() + index;
+    }
+
+    // Удаление последнего элемента
+    constexpr void PopBack() {
+        assert(size_ > 0 && "PopBack called on an empty container");
+        --size_;
+        data_[size_] = Type();
+    }
+
+    // Удаление элемента
+    constexpr Iterator Erase(ConstIterator pos) {
+        if (pos < begin() || pos >= end()) {
+            throw std::out_of_range("Erase position out of range");
+        }
+        const size_t index = pos - cbegin();
+        for (size_t i = index + 1; i < size_; ++i) {
+            data_[i - 1] = std::move(data_[i]);
+        }
+        PopBack();
+        return begin() + index;
+    }
+
+    // Обмен с другим вектором: поэлементный, буфер встроен
+    constexpr void swap(StaticSimpleVector& other) {
+        const size_t longest = size_ > other.size_ ? size_ : other.size_;
+        for (size_t i = 0; i < longest; ++i) {
+            Type tmp = std::move(data_[i]);
+            data_[i] = std::move(other.data_[i]);
+            other.data_[i] = std::move(tmp);
+        }
+        const size_t size = size_;
+        size_ = other.size_;
+        other.size_ = size;
+    }
+
+private:
+    Type data_[N] = {};
+    size_t size_ = 0;
+};
+
+// Операторы сравнения. Во время выполнения идут через векторные ядра,
+// на этапе компиляции — простым циклом
+
+template <typename Type, size_t N, typename OverflowPolicy>
+constexpr bool operator<(const StaticSimpleVector<Type, N, OverflowPolicy>& lhs, const StaticSimpleVector<Type, N, OverflowPolicy>& rhs) {
+    if (!IsConstantEvaluated()) {
+        return RangeLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+    }
+    for (size_t i = 0; i < lhs.GetSize() && i < rhs.GetSize(); ++i) {
+        if (lhs[i] < rhs[i]) {
+            return true;
+        }
+        if (rhs[i] < lhs[i]) {
+            return false;
+        }
+    }
+    return lhs.GetSize() < rhs.GetSize();
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+constexpr bool operator==(const StaticSimpleVector<Type, N, OverflowPolicy>& lhs, const StaticSimpleVector<Type, N, OverflowPolicy>& rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    if (!IsConstantEvaluated()) {
+        return RangeEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
+    }
+    for (size_t i = 0; i < lhs.GetSize(); ++i) {
+        if (!(lhs[i] == rhs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+constexpr bool operator!=(const StaticSimpleVector<Type, N, OverflowPolicy>& lhs, const StaticSimpleVector<Type, N, OverflowPolicy>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+constexpr bool operator>(const StaticSimpleVector<Type, N, OverflowPolicy>& lhs, const StaticSimpleVector<Type, N, OverflowPolicy>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+constexpr bool operator<=(const StaticSimpleVector<Type, N, OverflowPolicy>& lhs, const StaticSimpleVector<Type, N, OverflowPolicy>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, size_t N, typename OverflowPolicy>
+constexpr bool operator>=(const StaticSimpleVector<Type, N, OverflowPolicy>& lhs, const StaticSimpleVector<Type, N, OverflowPolicy>& rhs) {
+    return !(lhs < rhs);
+}